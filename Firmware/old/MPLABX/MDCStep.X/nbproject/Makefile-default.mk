@@ -51,17 +51,17 @@ OBJECTDIR=build/${CND_CONF}/${IMAGE_TYPE}
 DISTDIR=dist/${CND_CONF}/${IMAGE_TYPE}
 
 # Source Files Quoted if spaced
-SOURCEFILES_QUOTED_IF_SPACED=../src/config/default/peripheral/clk/plib_clk.c ../src/config/default/peripheral/coretimer/plib_coretimer.c ../src/config/default/peripheral/evic/plib_evic.c ../src/config/default/peripheral/gpio/plib_gpio.c ../src/config/default/peripheral/i2c/master/plib_i2c1_master.c ../src/config/default/peripheral/i2c/plib_i2c_smbus_common.c ../src/config/default/peripheral/uart/plib_uart1.c ../src/config/default/stdio/xc32_monitor.c ../src/config/default/initialization.c ../src/config/default/interrupts.c ../src/config/default/exceptions.c ../src/main.c ../src/ModbusSlave.c ../src/tlv493d.c ../src/endstop.c
+SOURCEFILES_QUOTED_IF_SPACED=../src/config/default/peripheral/clk/plib_clk.c ../src/config/default/peripheral/coretimer/plib_coretimer.c ../src/config/default/peripheral/evic/plib_evic.c ../src/config/default/peripheral/gpio/plib_gpio.c ../src/config/default/peripheral/i2c/master/plib_i2c1_master.c ../src/config/default/peripheral/i2c/plib_i2c_smbus_common.c ../src/config/default/peripheral/uart/plib_uart1.c ../src/config/default/stdio/xc32_monitor.c ../src/config/default/initialization.c ../src/config/default/interrupts.c ../src/config/default/exceptions.c ../src/main.c ../src/ModbusSlave.c ../src/tlv493d.c ../src/endstop.c ../src/diag.c ../src/supervisor.c ../src/fault.c ../src/tlv493d_atan2.c ../src/nvstore.c ../src/tlv493d_cal.c ../src/tlv493d_fifo.c ../src/tlv493d_filter.c ../src/i2cbus.c ../src/tlv493d_field.c ../src/endstop_log.c ../src/debounce.c ../src/inputs.c ../src/endstop_cfg.c ../src/portsnap.c ../src/adcscan.c ../src/inhibit.c ../src/pwrmon.c ../src/joystick.c ../src/irqplan.c ../src/seqring.c
 
 # Object Files Quoted if spaced
-OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/_ext/60165520/plib_clk.o ${OBJECTDIR}/_ext/1249264884/plib_coretimer.o ${OBJECTDIR}/_ext/1865200349/plib_evic.o ${OBJECTDIR}/_ext/1865254177/plib_gpio.o ${OBJECTDIR}/_ext/513455433/plib_i2c1_master.o ${OBJECTDIR}/_ext/60169480/plib_i2c_smbus_common.o ${OBJECTDIR}/_ext/1865657120/plib_uart1.o ${OBJECTDIR}/_ext/163028504/xc32_monitor.o ${OBJECTDIR}/_ext/1171490990/initialization.o ${OBJECTDIR}/_ext/1171490990/interrupts.o ${OBJECTDIR}/_ext/1171490990/exceptions.o ${OBJECTDIR}/_ext/1360937237/main.o ${OBJECTDIR}/_ext/1360937237/ModbusSlave.o ${OBJECTDIR}/_ext/1360937237/tlv493d.o ${OBJECTDIR}/_ext/1360937237/endstop.o
-POSSIBLE_DEPFILES=${OBJECTDIR}/_ext/60165520/plib_clk.o.d ${OBJECTDIR}/_ext/1249264884/plib_coretimer.o.d ${OBJECTDIR}/_ext/1865200349/plib_evic.o.d ${OBJECTDIR}/_ext/1865254177/plib_gpio.o.d ${OBJECTDIR}/_ext/513455433/plib_i2c1_master.o.d ${OBJECTDIR}/_ext/60169480/plib_i2c_smbus_common.o.d ${OBJECTDIR}/_ext/1865657120/plib_uart1.o.d ${OBJECTDIR}/_ext/163028504/xc32_monitor.o.d ${OBJECTDIR}/_ext/1171490990/initialization.o.d ${OBJECTDIR}/_ext/1171490990/interrupts.o.d ${OBJECTDIR}/_ext/1171490990/exceptions.o.d ${OBJECTDIR}/_ext/1360937237/main.o.d ${OBJECTDIR}/_ext/1360937237/ModbusSlave.o.d ${OBJECTDIR}/_ext/1360937237/tlv493d.o.d ${OBJECTDIR}/_ext/1360937237/endstop.o.d
+OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/_ext/60165520/plib_clk.o ${OBJECTDIR}/_ext/1249264884/plib_coretimer.o ${OBJECTDIR}/_ext/1865200349/plib_evic.o ${OBJECTDIR}/_ext/1865254177/plib_gpio.o ${OBJECTDIR}/_ext/513455433/plib_i2c1_master.o ${OBJECTDIR}/_ext/60169480/plib_i2c_smbus_common.o ${OBJECTDIR}/_ext/1865657120/plib_uart1.o ${OBJECTDIR}/_ext/163028504/xc32_monitor.o ${OBJECTDIR}/_ext/1171490990/initialization.o ${OBJECTDIR}/_ext/1171490990/interrupts.o ${OBJECTDIR}/_ext/1171490990/exceptions.o ${OBJECTDIR}/_ext/1360937237/main.o ${OBJECTDIR}/_ext/1360937237/ModbusSlave.o ${OBJECTDIR}/_ext/1360937237/tlv493d.o ${OBJECTDIR}/_ext/1360937237/endstop.o ${OBJECTDIR}/_ext/1360937237/diag.o ${OBJECTDIR}/_ext/1360937237/supervisor.o ${OBJECTDIR}/_ext/1360937237/fault.o ${OBJECTDIR}/_ext/1360937237/tlv493d_atan2.o ${OBJECTDIR}/_ext/1360937237/nvstore.o ${OBJECTDIR}/_ext/1360937237/tlv493d_cal.o ${OBJECTDIR}/_ext/1360937237/tlv493d_fifo.o ${OBJECTDIR}/_ext/1360937237/tlv493d_filter.o ${OBJECTDIR}/_ext/1360937237/i2cbus.o ${OBJECTDIR}/_ext/1360937237/tlv493d_field.o ${OBJECTDIR}/_ext/1360937237/endstop_log.o ${OBJECTDIR}/_ext/1360937237/debounce.o ${OBJECTDIR}/_ext/1360937237/inputs.o ${OBJECTDIR}/_ext/1360937237/endstop_cfg.o ${OBJECTDIR}/_ext/1360937237/portsnap.o ${OBJECTDIR}/_ext/1360937237/adcscan.o ${OBJECTDIR}/_ext/1360937237/inhibit.o ${OBJECTDIR}/_ext/1360937237/pwrmon.o ${OBJECTDIR}/_ext/1360937237/joystick.o ${OBJECTDIR}/_ext/1360937237/irqplan.o ${OBJECTDIR}/_ext/1360937237/seqring.o
+POSSIBLE_DEPFILES=${OBJECTDIR}/_ext/60165520/plib_clk.o.d ${OBJECTDIR}/_ext/1249264884/plib_coretimer.o.d ${OBJECTDIR}/_ext/1865200349/plib_evic.o.d ${OBJECTDIR}/_ext/1865254177/plib_gpio.o.d ${OBJECTDIR}/_ext/513455433/plib_i2c1_master.o.d ${OBJECTDIR}/_ext/60169480/plib_i2c_smbus_common.o.d ${OBJECTDIR}/_ext/1865657120/plib_uart1.o.d ${OBJECTDIR}/_ext/163028504/xc32_monitor.o.d ${OBJECTDIR}/_ext/1171490990/initialization.o.d ${OBJECTDIR}/_ext/1171490990/interrupts.o.d ${OBJECTDIR}/_ext/1171490990/exceptions.o.d ${OBJECTDIR}/_ext/1360937237/main.o.d ${OBJECTDIR}/_ext/1360937237/ModbusSlave.o.d ${OBJECTDIR}/_ext/1360937237/tlv493d.o.d ${OBJECTDIR}/_ext/1360937237/endstop.o.d ${OBJECTDIR}/_ext/1360937237/diag.o.d ${OBJECTDIR}/_ext/1360937237/supervisor.o.d ${OBJECTDIR}/_ext/1360937237/fault.o.d ${OBJECTDIR}/_ext/1360937237/tlv493d_atan2.o.d ${OBJECTDIR}/_ext/1360937237/nvstore.o.d ${OBJECTDIR}/_ext/1360937237/tlv493d_cal.o.d ${OBJECTDIR}/_ext/1360937237/tlv493d_fifo.o.d ${OBJECTDIR}/_ext/1360937237/tlv493d_filter.o.d ${OBJECTDIR}/_ext/1360937237/i2cbus.o.d ${OBJECTDIR}/_ext/1360937237/tlv493d_field.o.d ${OBJECTDIR}/_ext/1360937237/endstop_log.o.d ${OBJECTDIR}/_ext/1360937237/debounce.o.d ${OBJECTDIR}/_ext/1360937237/inputs.o.d ${OBJECTDIR}/_ext/1360937237/endstop_cfg.o.d ${OBJECTDIR}/_ext/1360937237/portsnap.o.d ${OBJECTDIR}/_ext/1360937237/adcscan.o.d ${OBJECTDIR}/_ext/1360937237/inhibit.o.d ${OBJECTDIR}/_ext/1360937237/pwrmon.o.d ${OBJECTDIR}/_ext/1360937237/joystick.o.d ${OBJECTDIR}/_ext/1360937237/irqplan.o.d ${OBJECTDIR}/_ext/1360937237/seqring.o.d
 
 # Object Files
-OBJECTFILES=${OBJECTDIR}/_ext/60165520/plib_clk.o ${OBJECTDIR}/_ext/1249264884/plib_coretimer.o ${OBJECTDIR}/_ext/1865200349/plib_evic.o ${OBJECTDIR}/_ext/1865254177/plib_gpio.o ${OBJECTDIR}/_ext/513455433/plib_i2c1_master.o ${OBJECTDIR}/_ext/60169480/plib_i2c_smbus_common.o ${OBJECTDIR}/_ext/1865657120/plib_uart1.o ${OBJECTDIR}/_ext/163028504/xc32_monitor.o ${OBJECTDIR}/_ext/1171490990/initialization.o ${OBJECTDIR}/_ext/1171490990/interrupts.o ${OBJECTDIR}/_ext/1171490990/exceptions.o ${OBJECTDIR}/_ext/1360937237/main.o ${OBJECTDIR}/_ext/1360937237/ModbusSlave.o ${OBJECTDIR}/_ext/1360937237/tlv493d.o ${OBJECTDIR}/_ext/1360937237/endstop.o
+OBJECTFILES=${OBJECTDIR}/_ext/60165520/plib_clk.o ${OBJECTDIR}/_ext/1249264884/plib_coretimer.o ${OBJECTDIR}/_ext/1865200349/plib_evic.o ${OBJECTDIR}/_ext/1865254177/plib_gpio.o ${OBJECTDIR}/_ext/513455433/plib_i2c1_master.o ${OBJECTDIR}/_ext/60169480/plib_i2c_smbus_common.o ${OBJECTDIR}/_ext/1865657120/plib_uart1.o ${OBJECTDIR}/_ext/163028504/xc32_monitor.o ${OBJECTDIR}/_ext/1171490990/initialization.o ${OBJECTDIR}/_ext/1171490990/interrupts.o ${OBJECTDIR}/_ext/1171490990/exceptions.o ${OBJECTDIR}/_ext/1360937237/main.o ${OBJECTDIR}/_ext/1360937237/ModbusSlave.o ${OBJECTDIR}/_ext/1360937237/tlv493d.o ${OBJECTDIR}/_ext/1360937237/endstop.o ${OBJECTDIR}/_ext/1360937237/diag.o ${OBJECTDIR}/_ext/1360937237/supervisor.o ${OBJECTDIR}/_ext/1360937237/fault.o ${OBJECTDIR}/_ext/1360937237/tlv493d_atan2.o ${OBJECTDIR}/_ext/1360937237/nvstore.o ${OBJECTDIR}/_ext/1360937237/tlv493d_cal.o ${OBJECTDIR}/_ext/1360937237/tlv493d_fifo.o ${OBJECTDIR}/_ext/1360937237/tlv493d_filter.o ${OBJECTDIR}/_ext/1360937237/i2cbus.o ${OBJECTDIR}/_ext/1360937237/tlv493d_field.o ${OBJECTDIR}/_ext/1360937237/endstop_log.o ${OBJECTDIR}/_ext/1360937237/debounce.o ${OBJECTDIR}/_ext/1360937237/inputs.o ${OBJECTDIR}/_ext/1360937237/endstop_cfg.o ${OBJECTDIR}/_ext/1360937237/portsnap.o ${OBJECTDIR}/_ext/1360937237/adcscan.o ${OBJECTDIR}/_ext/1360937237/inhibit.o ${OBJECTDIR}/_ext/1360937237/pwrmon.o ${OBJECTDIR}/_ext/1360937237/joystick.o ${OBJECTDIR}/_ext/1360937237/irqplan.o ${OBJECTDIR}/_ext/1360937237/seqring.o
 
 # Source Files
-SOURCEFILES=../src/config/default/peripheral/clk/plib_clk.c ../src/config/default/peripheral/coretimer/plib_coretimer.c ../src/config/default/peripheral/evic/plib_evic.c ../src/config/default/peripheral/gpio/plib_gpio.c ../src/config/default/peripheral/i2c/master/plib_i2c1_master.c ../src/config/default/peripheral/i2c/plib_i2c_smbus_common.c ../src/config/default/peripheral/uart/plib_uart1.c ../src/config/default/stdio/xc32_monitor.c ../src/config/default/initialization.c ../src/config/default/interrupts.c ../src/config/default/exceptions.c ../src/main.c ../src/ModbusSlave.c ../src/tlv493d.c ../src/endstop.c
+SOURCEFILES=../src/config/default/peripheral/clk/plib_clk.c ../src/config/default/peripheral/coretimer/plib_coretimer.c ../src/config/default/peripheral/evic/plib_evic.c ../src/config/default/peripheral/gpio/plib_gpio.c ../src/config/default/peripheral/i2c/master/plib_i2c1_master.c ../src/config/default/peripheral/i2c/plib_i2c_smbus_common.c ../src/config/default/peripheral/uart/plib_uart1.c ../src/config/default/stdio/xc32_monitor.c ../src/config/default/initialization.c ../src/config/default/interrupts.c ../src/config/default/exceptions.c ../src/main.c ../src/ModbusSlave.c ../src/tlv493d.c ../src/endstop.c ../src/diag.c ../src/supervisor.c ../src/fault.c ../src/tlv493d_atan2.c ../src/nvstore.c ../src/tlv493d_cal.c ../src/tlv493d_fifo.c ../src/tlv493d_filter.c ../src/i2cbus.c ../src/tlv493d_field.c ../src/endstop_log.c ../src/debounce.c ../src/inputs.c ../src/endstop_cfg.c ../src/portsnap.c ../src/adcscan.c ../src/inhibit.c ../src/pwrmon.c ../src/joystick.c ../src/irqplan.c ../src/seqring.c
 
 
 
@@ -191,6 +191,132 @@ ${OBJECTDIR}/_ext/1360937237/endstop.o: ../src/endstop.c  .generated_files/flags
 	@${RM} ${OBJECTDIR}/_ext/1360937237/endstop.o 
 	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/endstop.o.d" -o ${OBJECTDIR}/_ext/1360937237/endstop.o ../src/endstop.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
 	
+${OBJECTDIR}/_ext/1360937237/diag.o: ../src/diag.c  .generated_files/flags/default/fd02a037cac575f1f23263c6074b4e5ba6f04e6e .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/diag.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/diag.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/diag.o.d" -o ${OBJECTDIR}/_ext/1360937237/diag.o ../src/diag.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/1360937237/supervisor.o: ../src/supervisor.c  .generated_files/flags/default/ccbe796514fb9917335a98e7a7db826c0c8b0f4c .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/supervisor.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/supervisor.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/supervisor.o.d" -o ${OBJECTDIR}/_ext/1360937237/supervisor.o ../src/supervisor.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/1360937237/fault.o: ../src/fault.c  .generated_files/flags/default/bc1f075a295adb858b916b6b16e52d19691d35de .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/fault.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/fault.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/fault.o.d" -o ${OBJECTDIR}/_ext/1360937237/fault.o ../src/fault.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/1360937237/tlv493d_atan2.o: ../src/tlv493d_atan2.c  .generated_files/flags/default/c34dd2c030c303d9e8d68af638e536b29874acf2 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/tlv493d_atan2.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/tlv493d_atan2.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/tlv493d_atan2.o.d" -o ${OBJECTDIR}/_ext/1360937237/tlv493d_atan2.o ../src/tlv493d_atan2.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/1360937237/nvstore.o: ../src/nvstore.c  .generated_files/flags/default/1a645044ce4e19e835ef0b9c6d1fede72352ae30 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/nvstore.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/nvstore.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/nvstore.o.d" -o ${OBJECTDIR}/_ext/1360937237/nvstore.o ../src/nvstore.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/1360937237/tlv493d_cal.o: ../src/tlv493d_cal.c  .generated_files/flags/default/f6d9bd6c8c01fb658eb6f8a9bbd0749959dcbe08 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/tlv493d_cal.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/tlv493d_cal.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/tlv493d_cal.o.d" -o ${OBJECTDIR}/_ext/1360937237/tlv493d_cal.o ../src/tlv493d_cal.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/1360937237/tlv493d_fifo.o: ../src/tlv493d_fifo.c  .generated_files/flags/default/f506b567b0c0646b16f391299f10637470fb573b .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/tlv493d_fifo.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/tlv493d_fifo.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/tlv493d_fifo.o.d" -o ${OBJECTDIR}/_ext/1360937237/tlv493d_fifo.o ../src/tlv493d_fifo.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/1360937237/tlv493d_filter.o: ../src/tlv493d_filter.c  .generated_files/flags/default/c49a55aa500360921f88244198ca737bfe40da7c .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/tlv493d_filter.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/tlv493d_filter.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/tlv493d_filter.o.d" -o ${OBJECTDIR}/_ext/1360937237/tlv493d_filter.o ../src/tlv493d_filter.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/1360937237/i2cbus.o: ../src/i2cbus.c  .generated_files/flags/default/96cb8bc2c06cf85aa686d4a3d8d1e2c08a7adbb2 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/i2cbus.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/i2cbus.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/i2cbus.o.d" -o ${OBJECTDIR}/_ext/1360937237/i2cbus.o ../src/i2cbus.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/1360937237/tlv493d_field.o: ../src/tlv493d_field.c  .generated_files/flags/default/01d3a7218d4b21f2736000545fbbc8f01178434f .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/tlv493d_field.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/tlv493d_field.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/tlv493d_field.o.d" -o ${OBJECTDIR}/_ext/1360937237/tlv493d_field.o ../src/tlv493d_field.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/1360937237/endstop_log.o: ../src/endstop_log.c  .generated_files/flags/default/dc9d9d1522aa152c64bb365e416939f50a14c3a2 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/endstop_log.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/endstop_log.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/endstop_log.o.d" -o ${OBJECTDIR}/_ext/1360937237/endstop_log.o ../src/endstop_log.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/1360937237/debounce.o: ../src/debounce.c  .generated_files/flags/default/380e78261aa3b06bf511bad528c515b529c3a817 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/debounce.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/debounce.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/debounce.o.d" -o ${OBJECTDIR}/_ext/1360937237/debounce.o ../src/debounce.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/1360937237/inputs.o: ../src/inputs.c  .generated_files/flags/default/5dcacfd3c90297a98d1e9e662820ff88de67bd7f .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/inputs.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/inputs.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/inputs.o.d" -o ${OBJECTDIR}/_ext/1360937237/inputs.o ../src/inputs.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/1360937237/endstop_cfg.o: ../src/endstop_cfg.c  .generated_files/flags/default/074e87da94903c1dadac1f70eca1461f47114775 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/endstop_cfg.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/endstop_cfg.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/endstop_cfg.o.d" -o ${OBJECTDIR}/_ext/1360937237/endstop_cfg.o ../src/endstop_cfg.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/1360937237/portsnap.o: ../src/portsnap.c  .generated_files/flags/default/7c8c93c37576bf11da02e5a97db5b303f58f1213 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/portsnap.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/portsnap.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/portsnap.o.d" -o ${OBJECTDIR}/_ext/1360937237/portsnap.o ../src/portsnap.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/1360937237/adcscan.o: ../src/adcscan.c  .generated_files/flags/default/5edb76127b478bab6ae232605cae56c24bb5134f .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/adcscan.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/adcscan.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/adcscan.o.d" -o ${OBJECTDIR}/_ext/1360937237/adcscan.o ../src/adcscan.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/1360937237/inhibit.o: ../src/inhibit.c  .generated_files/flags/default/57403507435c0b32016f241ab656720763911571 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/inhibit.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/inhibit.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/inhibit.o.d" -o ${OBJECTDIR}/_ext/1360937237/inhibit.o ../src/inhibit.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/1360937237/pwrmon.o: ../src/pwrmon.c  .generated_files/flags/default/2ec04427054d6b9ec3eae80dd2d0ac9a6690bec3 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/pwrmon.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/pwrmon.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/pwrmon.o.d" -o ${OBJECTDIR}/_ext/1360937237/pwrmon.o ../src/pwrmon.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/1360937237/joystick.o: ../src/joystick.c  .generated_files/flags/default/a316a02a95b15812024d29a54822b3903d44eb7e .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/joystick.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/joystick.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/joystick.o.d" -o ${OBJECTDIR}/_ext/1360937237/joystick.o ../src/joystick.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/1360937237/irqplan.o: ../src/irqplan.c  .generated_files/flags/default/3494a4d82c73190b4fe9428bcd9edce47892008f .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/irqplan.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/irqplan.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/irqplan.o.d" -o ${OBJECTDIR}/_ext/1360937237/irqplan.o ../src/irqplan.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/1360937237/seqring.o: ../src/seqring.c  .generated_files/flags/default/7baef5c5cd638c746d682fc8a87a950fca06e85b .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/seqring.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/seqring.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/seqring.o.d" -o ${OBJECTDIR}/_ext/1360937237/seqring.o ../src/seqring.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
 else
 ${OBJECTDIR}/_ext/60165520/plib_clk.o: ../src/config/default/peripheral/clk/plib_clk.c  .generated_files/flags/default/99557a4f20615e6f0552c1c1af7e4b4b99d20d6c .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
 	@${MKDIR} "${OBJECTDIR}/_ext/60165520" 
@@ -282,6 +408,132 @@ ${OBJECTDIR}/_ext/1360937237/endstop.o: ../src/endstop.c  .generated_files/flags
 	@${RM} ${OBJECTDIR}/_ext/1360937237/endstop.o 
 	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/endstop.o.d" -o ${OBJECTDIR}/_ext/1360937237/endstop.o ../src/endstop.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
 	
+${OBJECTDIR}/_ext/1360937237/diag.o: ../src/diag.c  .generated_files/flags/default/dd8bd46bf1c13cac85f67aaf487f4cf74736971b .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/diag.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/diag.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/diag.o.d" -o ${OBJECTDIR}/_ext/1360937237/diag.o ../src/diag.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/1360937237/supervisor.o: ../src/supervisor.c  .generated_files/flags/default/74b8f7963e9c7f8af2d290ecf5178c628eb3075c .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/supervisor.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/supervisor.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/supervisor.o.d" -o ${OBJECTDIR}/_ext/1360937237/supervisor.o ../src/supervisor.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/1360937237/fault.o: ../src/fault.c  .generated_files/flags/default/fbe12f43f20d8e602935ec7bbf3616f0b6ddf638 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/fault.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/fault.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/fault.o.d" -o ${OBJECTDIR}/_ext/1360937237/fault.o ../src/fault.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/1360937237/tlv493d_atan2.o: ../src/tlv493d_atan2.c  .generated_files/flags/default/2070730bf8aa67de33cc39e6a3820eef0a073053 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/tlv493d_atan2.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/tlv493d_atan2.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/tlv493d_atan2.o.d" -o ${OBJECTDIR}/_ext/1360937237/tlv493d_atan2.o ../src/tlv493d_atan2.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/1360937237/nvstore.o: ../src/nvstore.c  .generated_files/flags/default/2f745940eb8092bd0630661c38b047826d248d43 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/nvstore.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/nvstore.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/nvstore.o.d" -o ${OBJECTDIR}/_ext/1360937237/nvstore.o ../src/nvstore.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/1360937237/tlv493d_cal.o: ../src/tlv493d_cal.c  .generated_files/flags/default/3f556127fac16d03a3aba3e07b89fc27cdde6c08 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/tlv493d_cal.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/tlv493d_cal.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/tlv493d_cal.o.d" -o ${OBJECTDIR}/_ext/1360937237/tlv493d_cal.o ../src/tlv493d_cal.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/1360937237/tlv493d_fifo.o: ../src/tlv493d_fifo.c  .generated_files/flags/default/dc2a26658b8021da086e6b47548a35e4aa5dfb4e .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/tlv493d_fifo.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/tlv493d_fifo.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/tlv493d_fifo.o.d" -o ${OBJECTDIR}/_ext/1360937237/tlv493d_fifo.o ../src/tlv493d_fifo.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/1360937237/tlv493d_filter.o: ../src/tlv493d_filter.c  .generated_files/flags/default/a29b3616802a70e328aa817541d6f7431ac81138 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/tlv493d_filter.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/tlv493d_filter.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/tlv493d_filter.o.d" -o ${OBJECTDIR}/_ext/1360937237/tlv493d_filter.o ../src/tlv493d_filter.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/1360937237/i2cbus.o: ../src/i2cbus.c  .generated_files/flags/default/cad76e02e4a18830ada6d57f922c6473a40cd2ef .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/i2cbus.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/i2cbus.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/i2cbus.o.d" -o ${OBJECTDIR}/_ext/1360937237/i2cbus.o ../src/i2cbus.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/1360937237/tlv493d_field.o: ../src/tlv493d_field.c  .generated_files/flags/default/5a988b9ea080b7c166ccc0c195204aaff903533d .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/tlv493d_field.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/tlv493d_field.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/tlv493d_field.o.d" -o ${OBJECTDIR}/_ext/1360937237/tlv493d_field.o ../src/tlv493d_field.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/1360937237/endstop_log.o: ../src/endstop_log.c  .generated_files/flags/default/9efe51fcc5f901ec6e65dd25a023c7de919aad3b .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/endstop_log.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/endstop_log.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/endstop_log.o.d" -o ${OBJECTDIR}/_ext/1360937237/endstop_log.o ../src/endstop_log.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/1360937237/debounce.o: ../src/debounce.c  .generated_files/flags/default/6ab3e1dd89d422cc12d461c8c8f449ba2804ef1e .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/debounce.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/debounce.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/debounce.o.d" -o ${OBJECTDIR}/_ext/1360937237/debounce.o ../src/debounce.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/1360937237/inputs.o: ../src/inputs.c  .generated_files/flags/default/fbcf80c52ea031fd438003fec19f562300ed0194 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/inputs.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/inputs.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/inputs.o.d" -o ${OBJECTDIR}/_ext/1360937237/inputs.o ../src/inputs.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/1360937237/endstop_cfg.o: ../src/endstop_cfg.c  .generated_files/flags/default/c0cc1f4cfbc989261492a42430978837e8350ad5 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/endstop_cfg.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/endstop_cfg.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/endstop_cfg.o.d" -o ${OBJECTDIR}/_ext/1360937237/endstop_cfg.o ../src/endstop_cfg.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/1360937237/portsnap.o: ../src/portsnap.c  .generated_files/flags/default/1e7e00cb1575231ec454af4bcf4f8a6bc053d1be .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/portsnap.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/portsnap.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/portsnap.o.d" -o ${OBJECTDIR}/_ext/1360937237/portsnap.o ../src/portsnap.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/1360937237/adcscan.o: ../src/adcscan.c  .generated_files/flags/default/65e4460ffdc2aa0982dea47fa7dcb37522917ae7 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/adcscan.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/adcscan.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/adcscan.o.d" -o ${OBJECTDIR}/_ext/1360937237/adcscan.o ../src/adcscan.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/1360937237/inhibit.o: ../src/inhibit.c  .generated_files/flags/default/a0af9e38c458742a6cb02104dd65459efc74d6ed .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/inhibit.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/inhibit.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/inhibit.o.d" -o ${OBJECTDIR}/_ext/1360937237/inhibit.o ../src/inhibit.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/1360937237/pwrmon.o: ../src/pwrmon.c  .generated_files/flags/default/cd6f8028639420e471cbadd451081807505e5c89 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/pwrmon.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/pwrmon.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/pwrmon.o.d" -o ${OBJECTDIR}/_ext/1360937237/pwrmon.o ../src/pwrmon.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/1360937237/joystick.o: ../src/joystick.c  .generated_files/flags/default/55bb3c25b7b00bd837d0a5f0f3610123bc677c8c .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/joystick.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/joystick.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/joystick.o.d" -o ${OBJECTDIR}/_ext/1360937237/joystick.o ../src/joystick.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/1360937237/irqplan.o: ../src/irqplan.c  .generated_files/flags/default/94b674c1430f732eda8670f9aca998d8aede6532 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/irqplan.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/irqplan.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/irqplan.o.d" -o ${OBJECTDIR}/_ext/1360937237/irqplan.o ../src/irqplan.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/1360937237/seqring.o: ../src/seqring.c  .generated_files/flags/default/cd57205e4940bba005dfbd6957d05d3e44680f24 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/seqring.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/seqring.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/seqring.o.d" -o ${OBJECTDIR}/_ext/1360937237/seqring.o ../src/seqring.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
 endif
 
 # ------------------------------------------------------------------------------------
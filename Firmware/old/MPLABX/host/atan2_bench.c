@@ -0,0 +1,135 @@
+/*
+ * atan2_bench.c - host benchmark for the TLV493D heading atan2
+ *
+ * Compares TLV493D_Atan2Cdeg() (src/tlv493d_atan2.c) with the former
+ * octant approximation from tlv493d.c (copied below, reference only):
+ * error against libm atan2() over all angles and 12-bit field strengths,
+ * and time per call.
+ *
+ * Build and run from Firmware/old/MPLABX:
+ *   cc -O1 -Isrc -o atan2_bench host/atan2_bench.c src/tlv493d_atan2.c -lm
+ *   ./atan2_bench
+ *
+ * Cycle counts are host cycles (rdtsc on x86, otherwise ns), useful for
+ * the ratio between the two. On the PIC32MM both are dominated by the
+ * single 32-bit divide.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+#include "tlv493d_atan2.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_UNIT  "cycles"
+static uint64_t BenchNow(void) { return __rdtsc(); }
+#else
+#define BENCH_UNIT  "ns"
+static uint64_t BenchNow(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+#endif
+
+/* ===================== Former implementation (whole degrees) ===================== */
+static int16_t OldWrap180(int16_t a)
+{
+    while (a > 180)  a = (int16_t)(a - 360);
+    while (a < -180) a = (int16_t)(a + 360);
+    return a;
+}
+
+static int16_t OldAtan2ApproxDeg(int16_t y, int16_t x)
+{
+    if (x == 0 && y == 0) return 0;
+
+    int32_t abs_y = (y < 0) ? -(int32_t)y : (int32_t)y;
+    int32_t abs_x = (x < 0) ? -(int32_t)x : (int32_t)x;
+
+    if (abs_y == 0) {
+        return (x < 0) ? 180 : 0;
+    }
+    if (abs_x == 0) {
+        return (y < 0) ? -90 : 90;
+    }
+
+    int32_t r_q15;
+    int32_t angle;
+    if (x >= 0) {
+        int32_t num = (int32_t)x - abs_y;
+        int32_t den = (int32_t)x + abs_y;
+        r_q15 = (den != 0) ? ((num << 15) / den) : 0;
+        angle = 45 - ((45 * r_q15) >> 15);
+    } else {
+        int32_t num = (int32_t)x + abs_y;
+        int32_t den = abs_y - (int32_t)x;
+        r_q15 = (den != 0) ? ((num << 15) / den) : 0;
+        angle = 135 - ((45 * r_q15) >> 15);
+    }
+
+    if (y < 0) angle = -angle;
+    return OldWrap180((int16_t)angle);
+}
+
+static int32_t OldCdeg(int16_t y, int16_t x) { return 100 * (int32_t)OldAtan2ApproxDeg(y, x); }
+static int32_t NewCdeg(int16_t y, int16_t x) { return TLV493D_Atan2Cdeg(y, x); }
+
+/* ===================== Test vectors ===================== */
+#define N_ANGLES    36000                   /* 0.01 degree steps */
+#define N_RADII     5
+
+static const int radii[N_RADII] = { 50, 200, 600, 1200, 2047 };   /* LSB, 12-bit full scale */
+static int16_t vx[N_RADII * N_ANGLES];
+static int16_t vy[N_RADII * N_ANGLES];
+static double  vref[N_RADII * N_ANGLES];    /* centidegrees of the quantised vector */
+
+typedef int32_t (*ATAN_FN)(int16_t y, int16_t x);
+
+static void Evaluate(const char *name, ATAN_FN fn)
+{
+    const int n = N_RADII * N_ANGLES;
+    double maxErr = 0.0, sumSq = 0.0;
+    volatile int32_t sink = 0;
+
+    for (int i = 0; i < n; i++) {
+        double e = (double)fn(vy[i], vx[i]) - vref[i];
+        if (e > 18000.0)  e -= 36000.0;
+        if (e < -18000.0) e += 36000.0;
+        if (fabs(e) > maxErr) maxErr = fabs(e);
+        sumSq += e * e;
+    }
+
+    uint64_t best = UINT64_MAX;
+    for (int rep = 0; rep < 20; rep++) {
+        uint64_t t0 = BenchNow();
+        for (int i = 0; i < n; i++) sink += fn(vy[i], vx[i]);
+        uint64_t dt = BenchNow() - t0;
+        if (dt < best) best = dt;
+    }
+    (void)sink;
+
+    printf("%-22s  max %7.3f deg  rms %7.4f deg  %6.1f %s/call\n",
+           name, maxErr / 100.0, sqrt(sumSq / n) / 100.0, (double)best / n, BENCH_UNIT);
+}
+
+int main(void)
+{
+    for (int r = 0; r < N_RADII; r++) {
+        for (int a = 0; a < N_ANGLES; a++) {
+            int i = r * N_ANGLES + a;
+            double th = (a - 18000) * M_PI / 18000.0;
+            vx[i] = (int16_t)lround(radii[r] * cos(th));
+            vy[i] = (int16_t)lround(radii[r] * sin(th));
+            vref[i] = atan2(vy[i], vx[i]) * 18000.0 / M_PI;
+        }
+    }
+
+    printf("%d vectors, |B| = 50..2047 LSB, error vs libm atan2 of the quantised vector\n",
+           N_RADII * N_ANGLES);
+    Evaluate("octant approx (deg)", OldCdeg);
+    Evaluate("TLV493D_Atan2Cdeg", NewCdeg);
+    return 0;
+}
@@ -0,0 +1,15 @@
+#ifndef DEFINITIONS_H
+#define DEFINITIONS_H
+
+/*
+ * Host stand-in for config/default/definitions.h
+ *
+ * The TLV493D driver needs nothing from the plibs except the I2C queue,
+ * and fake_i2cbus.c provides that. Put -Ihost ahead of -Isrc so this
+ * file is found instead of the MCC one.
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#endif /* DEFINITIONS_H */
@@ -0,0 +1,116 @@
+/*
+ * fake_i2cbus.c - i2cbus.c for the host harnesses, see fake_i2cbus.h
+ */
+#include "fake_i2cbus.h"
+
+static FAKE_I2C_DEVICE fakeDev = NULL;
+static uint32_t        fakeNow = 0u;
+
+static I2CBUS_Xfer_t  *fakeHead[I2CBUS_PRIO_COUNT];
+static I2CBUS_Xfer_t  *fakeTail[I2CBUS_PRIO_COUNT];
+static I2CBUS_Xfer_t  *fakeActive = NULL;
+static uint32_t        fakeStartT = 0u;
+static uint8_t         fakeDepth = 0u;
+
+static I2CBUS_Stats_t  fakeStats;
+
+void FAKE_I2C_SetDevice(FAKE_I2C_DEVICE dev)
+{
+    fakeDev = dev;
+}
+
+static void FAKE_StartNext(void)
+{
+    if (fakeActive != NULL) return;
+
+    for (uint8_t p = 0u; p < I2CBUS_PRIO_COUNT; p++) {
+        I2CBUS_Xfer_t *x = fakeHead[p];
+
+        if (x == NULL) continue;
+        fakeHead[p] = x->next;
+        if (fakeHead[p] == NULL) fakeTail[p] = NULL;
+        x->next = NULL;
+        x->state = I2CBUS_XFER_ACTIVE;
+        fakeActive = x;
+        fakeStartT = fakeNow;
+        return;
+    }
+}
+
+static void FAKE_Finish(I2CBUS_ERR err)
+{
+    I2CBUS_Xfer_t *x = fakeActive;
+
+    fakeActive = NULL;
+    fakeDepth--;
+    fakeStats.xfers++;
+    if (err != I2CBUS_ERR_NONE) fakeStats.errors++;
+
+    x->error = (uint8_t)err;
+    x->state = (err == I2CBUS_ERR_NONE) ? I2CBUS_XFER_DONE : I2CBUS_XFER_FAILED;
+    if (x->callback != NULL) x->callback(x);
+}
+
+void FAKE_I2C_Step(uint32_t now_ms)
+{
+    fakeNow = now_ms;
+
+    if (fakeActive != NULL && (uint32_t)(now_ms - fakeStartT) >= FAKE_I2C_XFER_MS) {
+        FAKE_Finish((fakeDev != NULL) ? fakeDev(fakeActive) : I2CBUS_ERR_NACK);
+    }
+    FAKE_StartNext();
+}
+
+void I2CBUS_Init(void)
+{
+}
+
+bool I2CBUS_Submit(I2CBUS_Xfer_t *x)
+{
+    if (x == NULL || I2CBUS_Pending(x)) return false;
+    if ((x->wbuf == NULL || x->wlen == 0u) && (x->rbuf == NULL || x->rlen == 0u)) return false;
+
+    uint8_t p = (x->prio < I2CBUS_PRIO_COUNT) ? x->prio : I2CBUS_PRIO_LOW;
+
+    x->state = I2CBUS_XFER_QUEUED;
+    x->error = I2CBUS_ERR_NONE;
+    x->next = NULL;
+    if (fakeTail[p] != NULL) fakeTail[p]->next = x;
+    else                     fakeHead[p] = x;
+    fakeTail[p] = x;
+
+    if (++fakeDepth > fakeStats.queueMax) fakeStats.queueMax = fakeDepth;
+    FAKE_StartNext();
+    return true;
+}
+
+bool I2CBUS_SetClockKHz(uint16_t khz)
+{
+    return khz >= I2CBUS_CLOCK_MIN_KHZ && khz <= I2CBUS_CLOCK_MAX_KHZ;
+}
+
+bool I2CBUS_Recover(void)
+{
+    fakeStats.recoveries++;
+    fakeStats.lastClocks = 0u;
+    if (fakeActive != NULL) FAKE_Finish(I2CBUS_ERR_ABORTED);
+    FAKE_StartNext();
+    return true;
+}
+
+bool I2CBUS_Task(uint32_t now_ms)
+{
+    (void)now_ms;
+    return true;
+}
+
+void I2CBUS_GetStats(I2CBUS_Stats_t *out)
+{
+    if (out != NULL) {
+        *out = fakeStats;
+    }
+}
+
+void I2CBUS_Task_250ms(void)
+{
+}
@@ -0,0 +1,28 @@
+#ifndef FAKE_I2CBUS_H
+#define FAKE_I2CBUS_H
+
+#include "i2cbus.h"
+
+/* =========================================================================
+ * Host replacement for i2cbus.c
+ *
+ * Same API and queue rules as the firmware (one transfer on the bus,
+ * highest priority first, FIFO within a priority). A transfer finishes
+ * FAKE_I2C_XFER_MS after it went on the bus, in FAKE_I2C_Step(); that is
+ * where the device model answers and the client callback runs, as it
+ * would from the I2C1 interrupt.
+ * ========================================================================= */
+#define FAKE_I2C_XFER_MS    1u      /* a 7-byte read at 50 kHz takes ~1.5 ms */
+
+/*
+ * Device model: fill x->rbuf, look at x->wbuf. Return I2CBUS_ERR_NONE to
+ * ACK the whole transfer, anything else to fail it with that error.
+ */
+typedef I2CBUS_ERR (*FAKE_I2C_DEVICE)(const I2CBUS_Xfer_t *x);
+
+void FAKE_I2C_SetDevice(FAKE_I2C_DEVICE dev);
+
+/** Advance the bus to now_ms: finish the active transfer if it is due, start the next. */
+void FAKE_I2C_Step(uint32_t now_ms);
+
+#endif /* FAKE_I2CBUS_H */
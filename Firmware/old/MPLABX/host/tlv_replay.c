@@ -0,0 +1,483 @@
+/*
+ * tlv_replay.c - host replay harness and benchmark for the TLV493D driver
+ *
+ * Runs the unmodified src/tlv493d.c (decode, sample ring, filter
+ * pipeline, heading, temperature, |B| check) on the host, on top of
+ * fake_i2cbus.c and a device model that answers the reset, factory
+ * read and config write and serves every 7-byte data read from a
+ * recording. The 1 ms tick, the I2C completion and TLV493D_Task() every
+ * 10 ms are called in the same order as on the target.
+ *
+ * Build and run from Firmware/old/MPLABX:
+ *   cc -O1 -Ihost -Isrc -o tlv_replay host/tlv_replay.c host/fake_i2cbus.c \
+ *      src/tlv493d.c src/tlv493d_atan2.c src/tlv493d_filter.c src/tlv493d_field.c -lm
+ *   ./tlv_replay --synth 20000 --write synth.txt
+ *   ./tlv_replay synth.txt --filter 3,2,1,2,3
+ *
+ * Recording, one data read per line ('#' starts a comment):
+ *   b0 b1 b2 b3 b4 b5 b6 [ref]    registers 0..6 in hex
+ *   nack [ref]                    the read failed
+ * ref is the true heading in centidegrees, optional. --synth generates a
+ * rotating magnet with noise, stale and incomplete frames and NACK
+ * bursts that force a bus recovery and a full reinit.
+ *
+ * Checks (exit code 1 on failure): every sample the driver delivers
+ * matches an independent decode of a served frame, samples + stale add
+ * up to the reads that were ACKed, errors to the NACKs, every reset after
+ * the first is counted as a reinit and every config write has odd parity. Accuracy is against ref: the raw atan2 of each
+ * sample, and the published heading (filter lag included).
+ *
+ * Cycle counts are host cycles (rdtsc on x86, otherwise ns), per read for
+ * the completion path (decode + ring push, I2C1 ISR on the target) and
+ * per sample for TLV493D_Task() (filters, heading, temperature, |B|).
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "tlv493d.h"
+#include "tlv493d_atan2.h"
+#include "tlv493d_cal.h"
+#include "fake_i2cbus.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_UNIT  "cycles"
+static uint64_t BenchNow(void) { return __rdtsc(); }
+#else
+#define BENCH_UNIT  "ns"
+static uint64_t BenchNow(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+#endif
+
+#define NO_REF          INT32_MIN
+#define PERIOD_MS       TLV493D_PERIOD_DEFAULT_MS
+#define TASK_MS         10u                 /* main loop cadence of TLV493D_Task() */
+#define TRUTH_LEN       256u                /* power of two */
+
+/* ===================== Recording ===================== */
+typedef struct {
+    uint8_t d[7];
+    bool    nack;
+    int32_t ref;                            /* centidegrees or NO_REF */
+} FRAME;
+
+static FRAME   *frames = NULL;
+static uint32_t nFrames = 0u;
+static uint32_t capFrames = 0u;
+
+static FRAME *AddFrame(void)
+{
+    if (nFrames == capFrames) {
+        capFrames = capFrames ? 2u * capFrames : 4096u;
+        frames = realloc(frames, capFrames * sizeof(FRAME));
+        if (frames == NULL) { perror("realloc"); exit(2); }
+    }
+    FRAME *f = &frames[nFrames++];
+    memset(f, 0, sizeof(*f));
+    f->ref = NO_REF;
+    return f;
+}
+
+static bool Load(const char *path)
+{
+    FILE *fp = fopen(path, "r");
+    char line[256];
+    unsigned lineNo = 0u;
+
+    if (fp == NULL) { perror(path); return false; }
+
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        char *hash = strchr(line, '#');
+        unsigned b[7];
+        long ref;
+        char word[8];
+        int n;
+
+        lineNo++;
+        if (hash != NULL) *hash = '\0';
+        if (sscanf(line, " %7s", word) != 1) continue;
+
+        if (strcmp(word, "nack") == 0) {
+            FRAME *f = AddFrame();
+            f->nack = true;
+            if (sscanf(line, " %*s %ld", &ref) == 1) f->ref = (int32_t)ref;
+            continue;
+        }
+        n = sscanf(line, " %x %x %x %x %x %x %x %ld", &b[0], &b[1], &b[2], &b[3], &b[4], &b[5], &b[6], &ref);
+        if (n < 7) {
+            fprintf(stderr, "%s:%u: expected 7 hex bytes or 'nack'\n", path, lineNo);
+            fclose(fp);
+            return false;
+        }
+        FRAME *f = AddFrame();
+        for (int i = 0; i < 7; i++) f->d[i] = (uint8_t)b[i];
+        if (n == 8) f->ref = (int32_t)ref;
+    }
+    fclose(fp);
+    return true;
+}
+
+static bool Save(const char *path)
+{
+    FILE *fp = fopen(path, "w");
+
+    if (fp == NULL) { perror(path); return false; }
+    fprintf(fp, "# TLV493D data reads: b0..b6 (hex) or nack, then heading in centidegrees\n");
+    for (uint32_t i = 0u; i < nFrames; i++) {
+        const FRAME *f = &frames[i];
+
+        if (f->nack) fprintf(fp, "nack");
+        else fprintf(fp, "%02x %02x %02x %02x %02x %02x %02x",
+                     f->d[0], f->d[1], f->d[2], f->d[3], f->d[4], f->d[5], f->d[6]);
+        if (f->ref != NO_REF) fprintf(fp, " %ld", (long)f->ref);
+        fputc('\n', fp);
+    }
+    fclose(fp);
+    return true;
+}
+
+/* ===================== Frame coding (datasheet layout, independent of the driver) ===================== */
+static void Encode(uint8_t d[7], int x, int y, int z, int t, uint8_t frm, uint8_t ch, bool pd)
+{
+    d[0] = (uint8_t)(x >> 4);
+    d[1] = (uint8_t)(y >> 4);
+    d[2] = (uint8_t)(z >> 4);
+    d[3] = (uint8_t)((((t >> 8) & 0x0F) << 4) | ((frm & 3u) << 2) | (ch & 3u));
+    d[4] = (uint8_t)(((x & 0x0F) << 4) | (y & 0x0F));
+    d[5] = (uint8_t)((1u << 5) | ((pd ? 1u : 0u) << 4) | (z & 0x0F));   /* FF=1, T=0 */
+    d[6] = (uint8_t)t;
+}
+
+static int Sext12(int v) { return (v & 0x800) ? v - 0x1000 : v; }
+
+typedef struct {
+    int16_t x, y, z, t;
+    uint8_t frm;
+    int32_t ref;
+} TRUTH;
+
+/* False for a frame the sensor marks as not usable (CH, PD, FF, T) */
+static bool RefDecode(const uint8_t d[7], TRUTH *o)
+{
+    if ((d[3] & 0x03u) != 0u || !(d[5] & 0x10u) || !(d[5] & 0x20u) || (d[5] & 0x40u)) return false;
+
+    o->x = (int16_t)Sext12((d[0] << 4) | (d[4] >> 4));
+    o->y = (int16_t)Sext12((d[1] << 4) | (d[4] & 0x0F));
+    o->z = (int16_t)Sext12((d[2] << 4) | (d[5] & 0x0F));
+    o->t = (int16_t)Sext12(((d[3] & 0xF0) << 4) | d[6]);
+    o->frm = (uint8_t)((d[3] >> 2) & 3u);
+    return true;
+}
+
+/* ===================== Synthetic recording ===================== */
+static uint64_t rng = 0x2545F4914F6CDD1Dull;
+
+static double Uniform(void)
+{
+    rng ^= rng << 13; rng ^= rng >> 7; rng ^= rng << 17;
+    return (double)(rng >> 11) / 9007199254740992.0;
+}
+
+static double Gauss(double sigma)
+{
+    double u = Uniform(), v = Uniform();
+    if (u < 1e-12) u = 1e-12;
+    return sigma * sqrt(-2.0 * log(u)) * cos(2.0 * M_PI * v);
+}
+
+static int Clamp12(double v)
+{
+    long r = lround(v);
+    return (int)((r > 2047) ? 2047 : ((r < -2048) ? -2048 : r));
+}
+
+/*
+ * Magnet swinging +-150 degrees with a 6 s period (up to ~160 deg/s),
+ * |B| 700 LSB, 2 LSB noise, die temperature drifting around 25 C.
+ * 3 % stale repeats, 0.5 % each conversion-in-progress (CH != 0) and
+ * PD = 0 frames, single NACKs, and a 5-NACK burst every 2500 reads
+ * (bus recovery and resume when a TLV493D_Task() call sees it) with a
+ * second one 300 reads after every fourth (sensor given up, full reinit).
+ */
+static void Synth(uint32_t n)
+{
+    uint8_t frm = 0u;
+    uint8_t prev[7] = {0};
+    bool havePrev = false;
+
+    for (uint32_t i = 0u; i < n; i++) {
+        double t = (double)i * PERIOD_MS / 1000.0;
+        double th = 150.0 * sin(2.0 * M_PI * t / 6.0) * M_PI / 180.0;
+        int x0 = Clamp12(700.0 * cos(th)), y0 = Clamp12(700.0 * sin(th));
+        FRAME *f = AddFrame();
+        double u = Uniform();
+
+        f->ref = (int32_t)lround(atan2(y0, x0) * 18000.0 / M_PI);
+
+        if ((i % 2500u) >= 1000u && (i % 2500u) < 1005u) { f->nack = true; continue; }
+        if ((i % 10000u) >= 1300u && (i % 10000u) < 1305u) { f->nack = true; continue; }
+        if (u < 0.004) { f->nack = true; continue; }
+
+        if (u < 0.034 && havePrev) {
+            memcpy(f->d, prev, 7);              /* read faster than the conversion */
+            continue;
+        }
+
+        int x = Clamp12(x0 + Gauss(2.0));
+        int y = Clamp12(y0 + Gauss(2.0));
+        int z = Clamp12(-250.0 + Gauss(2.0));
+        int temp = Clamp12(340.0 + 25.0 * sin(2.0 * M_PI * t / 40.0) + Gauss(0.7));
+
+        if (u < 0.039) {
+            Encode(f->d, x, y, z, temp, frm, 1u, true);     /* conversion in progress */
+        } else if (u < 0.044) {
+            Encode(f->d, x, y, z, temp, frm, 0u, false);    /* PD = 0 */
+        } else {
+            frm = (uint8_t)((frm + 1u) & 3u);
+            Encode(f->d, x, y, z, temp, frm, 0u, true);
+            memcpy(prev, f->d, 7);
+            havePrev = true;
+        }
+    }
+}
+
+/* ===================== Device model ===================== */
+#define SENSOR_ADDR     TLV493D_ADDR_RESET
+
+static const uint8_t devFactory[10] = { 0, 0, 0, 0, 0, 0, 0, 0x05u, 0x92u, 0x25u };
+
+static uint32_t frameIdx = 0u;
+static uint32_t servedOk = 0u, servedNack = 0u, servedBad = 0u;
+static uint32_t devResets = 0u, devConfigs = 0u, devParityErr = 0u;
+static uint64_t devCycles = 0u;
+
+static TRUTH    truth[TRUTH_LEN];
+static uint32_t truthHead = 0u, truthTail = 0u;
+
+static unsigned Popcount(uint8_t v) { unsigned n = 0u; while (v) { n += v & 1u; v >>= 1; } return n; }
+
+static I2CBUS_ERR Device(const I2CBUS_Xfer_t *x)
+{
+    uint64_t t0 = BenchNow();
+    I2CBUS_ERR err = I2CBUS_ERR_NONE;
+
+    if (x->addr == 0x00u) {
+        devResets++;                                    /* general call reset */
+    } else if (x->addr != SENSOR_ADDR) {
+        err = I2CBUS_ERR_NACK;
+    } else if (x->wlen == 4u) {
+        devConfigs++;
+        if (((Popcount(x->wbuf[0]) + Popcount(x->wbuf[1]) + Popcount(x->wbuf[2]) + Popcount(x->wbuf[3])) & 1u) == 0u) {
+            devParityErr++;
+        }
+    } else if (x->rlen == 10u) {
+        memcpy(x->rbuf, devFactory, 10);
+    } else if (x->rlen == 7u && frameIdx < nFrames) {
+        const FRAME *f = &frames[frameIdx++];
+
+        if (f->nack) {
+            servedNack++;
+            err = I2CBUS_ERR_NACK;
+        } else {
+            TRUTH tr;
+
+            memcpy(x->rbuf, f->d, 7);
+            servedOk++;
+            if (RefDecode(f->d, &tr)) {
+                tr.ref = f->ref;
+                truth[truthHead++ & (TRUTH_LEN - 1u)] = tr;
+                if (truthHead - truthTail > TRUTH_LEN) truthTail = truthHead - TRUTH_LEN;
+            } else {
+                servedBad++;
+            }
+        }
+    } else {
+        err = I2CBUS_ERR_NACK;                          /* recording exhausted */
+    }
+
+    devCycles += BenchNow() - t0;
+    return err;
+}
+
+/* ===================== Driver hooks ===================== */
+typedef struct {
+    double   maxErr;
+    double   sumSq;
+    uint32_t n;
+} ERRSTAT;
+
+static void ErrAdd(ERRSTAT *e, int32_t got_cdeg, int32_t ref_cdeg)
+{
+    double d = (double)(got_cdeg - ref_cdeg);
+
+    if (d > 18000.0)  d -= 36000.0;
+    if (d < -18000.0) d += 36000.0;
+    if (fabs(d) > e->maxErr) e->maxErr = fabs(d);
+    e->sumSq += d * d;
+    e->n++;
+}
+
+static ERRSTAT  rawErr, pubErr;
+static uint32_t decodeErr = 0u, delivered = 0u;
+static int32_t  lastRef = NO_REF;
+
+/* Calibration is not part of this harness */
+void TLV493D_CalFeed(const TLV493D_Sample_t *s)
+{
+    (void)s;
+}
+
+/* Match against the served frames; anything skipped was classed stale by the driver */
+void TLV493D_OnSample(const TLV493D_Sample_t *s)
+{
+    delivered++;
+    for (uint32_t i = truthTail; i != truthHead; i++) {
+        const TRUTH *tr = &truth[i & (TRUTH_LEN - 1u)];
+
+        if (tr->x == s->x && tr->y == s->y && tr->z == s->z && tr->t == s->temperature && tr->frm == s->frame) {
+            truthTail = i + 1u;
+            lastRef = tr->ref;
+            if (tr->ref != NO_REF) ErrAdd(&rawErr, TLV493D_Atan2Cdeg(s->y, s->x), tr->ref);
+            return;
+        }
+    }
+    decodeErr++;
+}
+
+/* ===================== Main ===================== */
+static void Usage(void)
+{
+    fprintf(stderr,
+            "usage: tlv_replay (FILE | --synth N) [--write FILE] [--filter M,D,O,S[,H]]\n"
+            "  --filter  median, decimation, IIR order, IIR shift, heading shift\n");
+}
+
+static void PrintErr(const char *name, const ERRSTAT *e)
+{
+    if (e->n == 0u) {
+        printf("  %-34s  no reference\n", name);
+        return;
+    }
+    printf("  %-34s  max %7.3f deg  rms %7.4f deg  (%u)\n",
+           name, e->maxErr / 100.0, sqrt(e->sumSq / e->n) / 100.0, e->n);
+}
+
+static bool Check(const char *name, bool ok)
+{
+    printf("  %-34s  %s\n", name, ok ? "ok" : "FAIL");
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    static const TLV493D_Config_t cfg[] = { { SENSOR_ADDR, NULL } };
+    const char *in = NULL, *out = NULL;
+    uint32_t synth = 0u;
+    TLV493D_FilterSet_t filt = {
+        .xyzt = { .median = 1u, .decim = 1u, .iirOrder = 0u, .iirShift = 1u },
+        .headingShift = TLV493D_HEADING_SHIFT_DEFAULT,
+        .headingHystCdeg = TLV493D_HEADING_HYST_DEFAULT,
+        .tempShift = TLV493D_TEMP_SHIFT_DEFAULT,
+        .tempHystTenths = TLV493D_TEMP_HYST_DEFAULT,
+    };
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--synth") == 0 && i + 1 < argc) {
+            synth = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--write") == 0 && i + 1 < argc) {
+            out = argv[++i];
+        } else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            unsigned m, d, o, s, h = filt.headingShift;
+            if (sscanf(argv[++i], "%u,%u,%u,%u,%u", &m, &d, &o, &s, &h) < 4) { Usage(); return 2; }
+            filt.xyzt.median = (uint8_t)m;
+            filt.xyzt.decim = (uint8_t)d;
+            filt.xyzt.iirOrder = (uint8_t)o;
+            filt.xyzt.iirShift = (uint8_t)s;
+            filt.headingShift = (uint8_t)h;
+        } else if (argv[i][0] != '-' && in == NULL) {
+            in = argv[i];
+        } else {
+            Usage();
+            return 2;
+        }
+    }
+    if ((in == NULL) == (synth == 0u)) { Usage(); return 2; }
+
+    if (synth != 0u) Synth(synth);
+    else if (!Load(in)) return 2;
+    if (out != NULL && !Save(out)) return 2;
+    if (nFrames == 0u) { fprintf(stderr, "no frames\n"); return 2; }
+
+    FAKE_I2C_SetDevice(Device);
+    I2CBUS_Init();
+    TLV493D_SetAcquisition(TLV493D_MODE_MCM, PERIOD_MS);
+    TLV493D_SetFilter(&filt);
+    TLV493D_Init(cfg, 1u);
+
+    uint64_t isrCycles = 0u, taskCycles = 0u;
+    uint32_t now = 0u;
+    const uint32_t limit = nFrames * PERIOD_MS * 4u + 10000u;   /* in case acquisition stalls */
+
+    while (frameIdx < nFrames && now < limit) {
+        uint64_t t0;
+        uint64_t dev0 = devCycles;
+
+        now++;
+
+        t0 = BenchNow();
+        FAKE_I2C_Step(now);                 /* completion callback: decode + ring push */
+        TLV493D_Tick_1ms(now);
+        isrCycles += (BenchNow() - t0) - (devCycles - dev0);
+
+        if ((now % TASK_MS) == 0u) {
+            int16_t h;
+            uint32_t age;
+
+            t0 = BenchNow();
+            TLV493D_Task(now);
+            taskCycles += BenchNow() - t0;
+
+            if (lastRef != NO_REF && TLV493D_GetHeadingCdeg(0u, &h, now, &age)) {
+                ErrAdd(&pubErr, h, lastRef);
+            }
+        }
+    }
+    TLV493D_Task(now + TASK_MS);            /* drain the rest */
+
+    TLV493D_Stats_t st;
+    TLV493D_GetStats(&st);
+
+    printf("%u reads (%s), %.1f s, filter median %u decim %u iir %u/%u heading shift %u\n",
+           nFrames, synth ? "synthetic" : in, now / 1000.0,
+           filt.xyzt.median, filt.xyzt.decim, filt.xyzt.iirOrder, filt.xyzt.iirShift, filt.headingShift);
+    printf("  served: %u ACK (%u not ready), %u NACK; %u resets, %u config writes\n",
+           servedOk, servedBad, servedNack, devResets, devConfigs);
+    printf("  driver: %u samples, %u stale, %u errors, %u overflows, %u resumes, %u reinits\n",
+           st.samples, st.stale, st.errors, st.overflows, st.resumes, st.reinits);
+
+    bool ok = true;
+    ok &= Check("replay complete", frameIdx == nFrames);
+    ok &= Check("samples match served frames", decodeErr == 0u && delivered == st.samples);
+    ok &= Check("samples + stale + overflows = ACKs", st.samples + st.stale + st.overflows == servedOk);
+    ok &= Check("errors = NACKs", st.errors == servedNack);
+    ok &= Check("config parity", devConfigs > 0u && devParityErr == 0u);
+    ok &= Check("reinits = resets after the first", st.reinits + 1u == devResets);
+
+    PrintErr("raw heading (atan2 per sample)", &rawErr);
+    PrintErr("published heading (incl. lag)", &pubErr);
+
+    if (servedOk + servedNack != 0u && st.samples != 0u) {
+        printf("  completion path   %8.1f %s/read\n", (double)isrCycles / (servedOk + servedNack), BENCH_UNIT);
+        printf("  TLV493D_Task      %8.1f %s/sample\n", (double)taskCycles / st.samples, BENCH_UNIT);
+    }
+    free(frames);
+    return ok ? 0 : 1;
+}
@@ -24,6 +24,7 @@
 /* ************************************************************************** */
 
 #include "ModbusSlave.h"
+#include "fault.h"
 
 
 /* ************************************************************************** */
@@ -62,6 +63,14 @@ uint8_t MBS_SlaveAddress = MBS_DEFAULT_ADDRESS;
  */
 volatile uint16_t MBS_HoldRegisters[MBS_NUMBER_OF_OUTPUT_REGISTERS];
 
+// *****************************************************************************
+/** Modbus Input Registers (read only from the host, function 4)
+
+  @Remarks
+    Written by the firmware modules, same byte order as the holding registers.
+ */
+volatile uint16_t MBS_InputRegisters[MBS_NUMBER_OF_INPUT_REGISTERS];
+
 
 // *****************************************************************************
 /** Slave Transmit and Receive Variables
@@ -80,7 +89,10 @@ uint8_t MBS_Rx_Data_Available = false;
 
 // Modbus RTU Variables
 volatile uint8_t MBS_ReceiveBuffer[MBS_RECEIVE_BUFFER_SIZE];   // Buffer to collect data from hardware
-volatile uint8_t MBS_ReceiveCounter=0;                                 // Collected data number
+volatile uint16_t MBS_ReceiveCounter=0;                                // Collected data number
+
+// The counter must be able to reach the buffer size
+_Static_assert(MBS_RECEIVE_BUFFER_SIZE <= UINT16_MAX, "MBS_ReceiveCounter too small for MBS_RECEIVE_BUFFER_SIZE");
 
 
 // *****************************************************************************
@@ -96,6 +108,15 @@ volatile uint8_t MBS_ReceiveCounter=0;                                 // Collec
 volatile uint32_t MBS_TimerValue;
 
 
+// *****************************************************************************
+/** Modbus Request Counter
+
+  @Description
+    Number of requests addressed to this slave (incl. broadcast) since boot.
+*/
+uint32_t MBS_RequestCounter = 0;
+
+
 
 /* ************************************************************************** */
 /* ************************************************************************** */
@@ -214,6 +235,7 @@ void MBS_HandleError(char ErrorCode)
     MBS_Tx_Data.Address     = MBS_SlaveAddress;
     MBS_Tx_Data.DataLen     = 1;
     MBS_Tx_Data.DataBuf[0]  = ErrorCode;
+    FAULT_Trace(FAULT_EV_MODBUS, (uint16_t)(((uint16_t)MBS_Rx_Data.Function << 8) | (uint8_t)ErrorCode));
     MBS_SendMessage();
 }
 
@@ -260,6 +282,54 @@ void MBS_Handle03ReadHoldingRegisters(void)
 }
 
 
+/******************************************************************************/
+/*
+ * Function Name        : MBS_Handle04ReadInputRegisters
+ * @How to use          : Modbus function 04 - Read input registers
+ */
+void MBS_Handle04ReadInputRegisters(void)
+{
+    // Input registers are read only values published by the firmware.
+    uint32_t MBS_StartAddress = 0;
+    uint32_t MBS_NumberOfRegisters = 0;
+    uint32_t MBS_i = 0;
+
+    // The message contains the requested start address and number of registers
+    MBS_StartAddress = ((uint32_t) (MBS_Rx_Data.DataBuf[0]) << 8) + (uint32_t) (MBS_Rx_Data.DataBuf[1]);
+    MBS_NumberOfRegisters = ((uint32_t) (MBS_Rx_Data.DataBuf[2]) << 8) + (uint32_t) (MBS_Rx_Data.DataBuf[3]);
+
+    // The register space is larger than one response
+    if(MBS_NumberOfRegisters>MBS_MAX_READ_REGISTERS)
+        MBS_HandleError(MBS_ERROR_CODE_03);
+    // If it is bigger than RegisterNumber return error to Modbus Master
+    else if((MBS_StartAddress+MBS_NumberOfRegisters)>MBS_NUMBER_OF_INPUT_REGISTERS)
+        MBS_HandleError(MBS_ERROR_CODE_02);
+    else
+    {
+        // Let the owner of the range refresh it (e.g. pop FIFO entries into it)
+        MBS_OnReadInputRegisters((uint16_t)MBS_StartAddress, (uint16_t)MBS_NumberOfRegisters);
+
+        // Initialize the output buffer. The first byte in the buffer says how many registers we have read
+        MBS_Tx_Data.Function = MBS_READ_INPUT_REGISTERS;
+        MBS_Tx_Data.Address = MBS_SlaveAddress;
+        MBS_Tx_Data.DataLen = 1;
+        MBS_Tx_Data.DataBuf[0] = 0;
+
+        for (MBS_i = 0; MBS_i < MBS_NumberOfRegisters; MBS_i++)
+        {
+            unsigned short MBS_CurrentData = MBS_InputRegisters[MBS_StartAddress+MBS_i];
+
+            MBS_Tx_Data.DataBuf[MBS_Tx_Data.DataLen] = (uint8_t) ((MBS_CurrentData & 0xFF00) >> 8);
+            MBS_Tx_Data.DataBuf[MBS_Tx_Data.DataLen + 1] = (uint8_t) (MBS_CurrentData & 0xFF);
+            MBS_Tx_Data.DataLen += 2;
+            MBS_Tx_Data.DataBuf[0] = MBS_Tx_Data.DataLen - 1;
+        }
+
+        MBS_SendMessage();
+    }
+}
+
+
 /******************************************************************************/
 /*
  * Function Name        : MBS_Handle06WriteSingleRegister
@@ -433,7 +503,7 @@ uint8_t MBS_CheckBufferComplete(void)
  */
 void MBS_RxRTU(void)
 {
-    uint8_t MBS_i;
+    uint16_t MBS_i;
     uint8_t MBS_ReceiveBufferControl=0;
 
     MBS_ReceiveBufferControl = MBS_CheckBufferComplete();
@@ -541,9 +611,11 @@ void MBS_InitModbus(uint8_t ModbusSlaveAddress)
     Modbus Slave Process procedure called in main event.
 
   @Remarks
-    NA
+    Returns true when the receiver is empty after this pass: idle, or a
+    frame was handled, dropped or timed out. A frame stuck half received
+    never gets there (task supervisor).
  */
-void MBS_ProcessModbus(void)
+bool MBS_ProcessModbus(void)
 {
     if (MBS_Tx_State != MBS_RXTX_IDLE)                                      // If answer is ready, send it!
         MBS_TxRTU();
@@ -557,6 +629,8 @@ void MBS_ProcessModbus(void)
             
             // We have a Host!
             mySystemTimeOutTimer=0;
+            MBS_RequestCounter++;
+            FAULT_Beat(FAULT_BEAT_MODBUS, (uint16_t)(((uint16_t)MBS_Rx_Data.Function << 8) | MBS_Rx_Data.DataBuf[1]));
             
             switch (MBS_Rx_Data.Function)                                     // Data is for us but which function?
             {
@@ -564,6 +638,10 @@ void MBS_ProcessModbus(void)
                     MBS_Handle03ReadHoldingRegisters();
                     break;
                 
+                case MBS_READ_INPUT_REGISTERS:
+                    MBS_Handle04ReadInputRegisters();
+                    break;
+                
                 case MBS_WRITE_SINGLE_REGISTER:
                     MBS_Handle06WriteSingleRegister();
                     break;
@@ -578,7 +656,8 @@ void MBS_ProcessModbus(void)
             }
         }
     }
-    
+
+    return (MBS_ReceiveCounter == 0u);
 }
 
 
@@ -595,12 +674,13 @@ void MBS_ProcessModbus(void)
  */
 void MBS_ReciveData(uint8_t Data)
 {
+    // Longer than any valid frame: start over, never past the end
+    if(MBS_ReceiveCounter>=MBS_RECEIVE_BUFFER_SIZE)
+        MBS_ReceiveCounter=0;
+
     MBS_ReceiveBuffer[MBS_ReceiveCounter] = Data;
     MBS_ReceiveCounter++;
 
-    if(MBS_ReceiveCounter>MBS_RECEIVE_BUFFER_SIZE)  
-        MBS_ReceiveCounter=0;
-
     MBS_TimerValue=0;   
 }
 
@@ -610,6 +690,13 @@ void __attribute__ ((weak)) MBS_UART_Putch(uint8_t ch)
     
 }
 
+/* Called by function 4 before the registers are copied. Default: no side effect. */
+void __attribute__ ((weak)) MBS_OnReadInputRegisters(uint16_t start, uint16_t count)
+{
+    (void)start;
+    (void)count;
+}
+
 /* *****************************************************************************
  End of File
  */
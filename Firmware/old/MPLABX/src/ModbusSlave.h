@@ -36,7 +36,7 @@
 
   @Description
     Small - cut to the bone - Modbus RTU Slave library. 
-    Support Modbus Functions 3, 6 and 16.
+    Support Modbus Functions 3, 4, 6 and 16.
 
  */
 /* ************************************************************************** */
@@ -71,7 +71,12 @@ extern "C" {
     /* ************************************************************************** */
     /** Modbus RTU Slave Output Register Number
      */
-#define MBS_NUMBER_OF_OUTPUT_REGISTERS      100
+#define MBS_NUMBER_OF_OUTPUT_REGISTERS      125                             // 125 = max per read (function 3)
+
+    /* ************************************************************************** */
+    /** Modbus RTU Slave Input Register Number (read only, function 4)
+     */
+#define MBS_NUMBER_OF_INPUT_REGISTERS       436
 
     /* ************************************************************************** */
     /** Modbus RTU Slave Addresses
@@ -86,6 +91,9 @@ extern "C" {
 #define MBS_TRANSMIT_BUFFER_SIZE            MBS_RECEIVE_BUFFER_SIZE
 #define MBS_RXTX_BUFFER_SIZE                MBS_TRANSMIT_BUFFER_SIZE
 
+    /* Max registers in one read response (function 3 and 4) */
+#define MBS_MAX_READ_REGISTERS              ((MBS_TRANSMIT_BUFFER_SIZE - 5) / 2)
+
     
     /* ************************************************************************** */
     /** Timeout Constant for Petit Modbus RTU Slave [millisecond]
@@ -99,7 +107,7 @@ extern "C" {
 //#define MBS_READ_COILS                      1
 //#define MBS_READ_DISCRETE_INPUTS            2
 #define MBS_READ_HOLDING_REGISTERS          3
-//#define MBS_READ_INPUT_REGISTERS            4
+#define MBS_READ_INPUT_REGISTERS            4
 //#define MBS_WRITE_SINGLE_COIL               5
 #define MBS_WRITE_SINGLE_REGISTER           6
 //#define MBS_WRITE_MULTIPLE_COILS            15
@@ -116,6 +124,7 @@ extern "C" {
 
 #define MBS_ERROR_CODE_01                   0x01                            // Function code is not supported
 #define MBS_ERROR_CODE_02                   0x02                            // Register address is not allowed or write-protected
+#define MBS_ERROR_CODE_03                   0x03                            // Register count out of range
 
 
     /* ************************************************************************** */
@@ -133,10 +142,20 @@ extern "C" {
 #define MBS_VERT_INPUT                      12                              // 12	vertInput	INT16	
 #define MBS_FOCUS_INPUT                     13                              // 13	focusInput	INT16	
 #define MBS_COMMAND                         14                              // 14	Command	UINT16	
+/* Joystick shaping (joystick.c), applied every 1 ms, out of range values clamped. FULL_SCALE: input
+ * at full deflection; DEADBAND in input units; EXPO 0..100 % cubic; RAMP_MS: 0 to full speed (0 = off);
+ * MAX_SPEED 0..511. */
+#define MBS_JS_FULL_SCALE                   15u
+#define MBS_JS_DEADBAND                     16u
+#define MBS_JS_EXPO                         17u
+#define MBS_JS_RAMP_MS                      18u
+#define MBS_JS_MAX_SPEED                    19u
 #define MBS_HORIZ_POS_RAW                   20                              // 20	Horizontal_pos_raw	INT16	
 #define MBS_VERT_POS_RAW                    21                              // 21	Vertical_pos_raw	INT16	
 #define MBS_SL_STATUS                       22                              // 22	SLStatus	UINT16	
 #define MBS_IGNITION_TIME                   24                              // 24	IgnitionTime	UINT16	
+/* POWER_IN_V from the background ADC scan (adcscan.c), mean of 16 scans in mV of the supply, every 10 ms.
+ * 25..27 and 29 are not written until their pins are analog in the MCC pin setup (adcscan.h). */
 #define MBS_MD_FOCUS_FB                     25                              // 25	MDFocusFB	UINT16	    uint16_t MD_FOCUS_FB_AN4
 #define MBS_MD_VERT_FB                      26                              // 26	MDVertFB	UINT16	    uint16_t MD_VERT_FB_AN5
 #define MBS_MD_HORIZ_FB                     27                              // 27	MDHorFB	UINT16	    uint16_t MD_HORIZ_FB_AN6
@@ -147,11 +166,13 @@ extern "C" {
 #define MBS_PORTB                           32                              // 32	portB	UINT16	    uint16_t PortB;       
 #define MBS_PORTC                           33                              // 33	portC	UINT16	    uint16_t PortC;       
 #define MBS_PORTD                           34                              // 34	portD	UINT16	    uint8_t PortD;       
-#define MBS_HORIZ_R5_SI                     35                              // 35   HorizR5SpeedIndex UINT16
-#define MBS_VERT_R5_SI                      36                              // 36   VertR5SpeedIndex UINT16
+#define MBS_HORIZ_R5_SI                     35                              // 35   HorizR5SpeedIndex INT16  shaped joystick speed with MBS_JS_SLAVE_ENABLED (joystick.c)
+#define MBS_VERT_R5_SI                      36                              // 36   VertR5SpeedIndex INT16   same
+#define MBS_PORTSNAP_PERIOD_MS              37                              // 37   GPIO snapshot period, ms, 0 = off (portsnap.c)
+#define MBS_INHIBIT_ACK                     38                              // 38   INHIBIT_SRC_xxx bits to release, cleared when handled (inhibit.c)
 #define MBS_HORIZ_PWR_LIMIT                 40                              // 40	HorizPowerLimit	UINT16	
 #define MBS_VERT_PWR_LIMIT                  41                              // 41	VertPowerLimit	UINT16	
-#define MBS_PWR_DROP_LIMIT                  42                              // 42	PowerDropLimit	UINT16	
+#define MBS_PWR_DROP_LIMIT                  42                              // 42	PowerDropLimit	UINT16  supply mV, 0 = off (pwrmon.c)
 //#define MBS_HORIZ_SLOW_STOP_FACTOR          43                              // 43	SlowStopHorz	UINT16	
 #define MBS_FOCUS_PWR_LIMIT                 43                              // 41	FocusPowerLimit	UINT16	
 //#define MBS_VERT_SLOW_STOP_FACTOR           44                              // 44	SlowStopVert	UINT16	
@@ -179,14 +200,297 @@ extern "C" {
 #define MBS_TLV493D_HEADING                 (MBS_TLV493D_X + 9u)            // int16: [-180..180]
 #define MBS_TLV493D_TEMP_C                  (MBS_TLV493D_X + 10u)           // int16: whole C    
 
-/* X5 FA output, PIC pin 41 / RC14. 0 = low, non-zero = high. */
+/* X5 FA output, PIC pin 41 / RC14. 0 = low, non-zero = high. Overridden while the motor inhibit is latched (inhibit.h). */
 #define MBS_X5_FA                           62u
 
+/* X5 FA endstop inhibit rules (inhibit.h), kept in flash with MBS_INCFG_CMD_SAVE. One word per rule:
+ * bits 0..3 inputs (bit per endstop_id_t), bit 15 INHIBIT_RULE_ALL: all of them active, else any one.
+ * 0 = rule off. Rule r latches source INHIBIT_SRC_RULE(r), released by MBS_INHIBIT_ACK. */
+#define MBS_INHIBIT_RULE_BASE               71u                             // INHIBIT_RULES words, 71..74
+
+/* TLV493D acquisition: mode TLV493D_MODE (0 = low-power 12 ms, 1 = MCM timer driven),
+ * period in ms for MCM (0 = default). Mode change restarts the sensor. */
+#define MBS_TLV493D_MODE                    63u
+#define MBS_TLV493D_PERIOD                  64u
+
+/* TLV493D heading in centidegrees, int16 [-18000..18000], filtered without hysteresis.
+ * MBS_TLV493D_HEADING (whole degrees) is kept for existing hosts. */
+#define MBS_TLV493D_HEADING_CDEG            65u
+
+/* TLV493D hard/soft-iron calibration (tlv493d_cal.c). Write TLV493D_CAL_CMD to
+ * CAL_CMD, firmware sets it back to 0 when handled. CAL_SENSOR: TLV493D_ID. */
+#define MBS_TLV493D_CAL_CMD                 66u
+#define MBS_TLV493D_CAL_SENSOR              67u
+
+/* TLV493D field magnitude check (tlv493d_field.h), |B| corrected to 25 C, 1 LSB = 98 uT.
+ * BMIN/BMAX: limits in LSB (0 = off), BTC: magnet temperature coefficient in ppm/K (int16).
+ * Any sensor outside sets MBS_SL_STATUS_MAGNET_WEAK / _SATURATED. */
+#define MBS_TLV493D_BMIN                    68u
+#define MBS_TLV493D_BMAX                    69u
+#define MBS_TLV493D_BTC                     70u
+
+/* TLV493D filter pipeline (TLV493D_FilterSet_t), applied every 250 ms, out of range values clamped.
+ * FILT_*: pre-filter on raw X/Y/Z/T: median of 1/3/5, decimation 1..16, IIR order 0..2, IIR shift 1..8.
+ * HEADING/TEMP_SHIFT: derived value IIR 1/2^n (0 = off). HEADING_HYST in 0.01 deg, TEMP_HYST in 0.1 C. */
+#define MBS_TLV493D_FILT_MEDIAN             89u
+#define MBS_TLV493D_FILT_DECIM              90u
+#define MBS_TLV493D_FILT_IIR_ORDER          91u
+#define MBS_TLV493D_FILT_IIR_SHIFT          92u
+#define MBS_TLV493D_HEADING_SHIFT           93u
+#define MBS_TLV493D_HEADING_HYST            94u
+#define MBS_TLV493D_TEMP_SHIFT              95u
+#define MBS_TLV493D_TEMP_HYST               96u
+
+/* I2C1 bus clock in kHz (i2cbus.c), 10..1000: 100 standard, 400 Fast-mode, 1000 Fast-mode Plus.
+ * Applied between two transfers; a refused value is replaced by the clock in use. */
+#define MBS_I2C_CLOCK_KHZ                   97u
+
+/* Diagnostics command, bit mask MBS_DIAG_CMD_xxx. Each bit is cleared by firmware when handled. */
+#define MBS_DIAG_COMMAND                    88u
+
+/* Endstop input table (endstop_cfg.c), applied every 250 ms, kept in flash with MBS_INCFG_CMD_SAVE.
+ * Per input in endstop_id_t order: POLARITY 0 = active low, 1 = active high; GLITCH_US: level must be
+ * steady this long (0 = off); STATUS: MBS_SL_STATUS bits while active. Per rule: both inputs A and B
+ * active sets STATUS (0 = rule off). Only the endstop bits of MBS_SL_STATUS are accepted, a refused
+ * value is replaced by the one in use. */
+#define MBS_INCFG_CMD                       100u                            // bit mask MBS_INCFG_CMD_xxx, cleared when handled
+#define MBS_INCFG_IN_BASE                   101u
+#define MBS_INCFG_IN_STRIDE                 3u
+#define MBS_INCFG_IN_POLARITY               0u
+#define MBS_INCFG_IN_GLITCH_US              1u
+#define MBS_INCFG_IN_STATUS                 2u
+#define MBS_INCFG_RULE_BASE                 113u                            // ENDSTOP_RULES blocks
+#define MBS_INCFG_RULE_STRIDE               3u
+#define MBS_INCFG_RULE_A                    0u
+#define MBS_INCFG_RULE_B                    1u
+#define MBS_INCFG_RULE_STATUS               2u
+
 //           556677889900
 #define MBS_FW_VER_DATE_TAG                 75                              // __DATE__ "Jan 24 2011"
                                                                             //                1122
 #define MBS_FW_VER_REV_TAG                  81                              // RevBuild "Rev.: 002"
 
+
+/* ================= Input Registers (function 4) =================
+ * ISR statistics, one block of MBS_IR_ISR_STRIDE registers per vector in
+ * DIAG_ISR_ID order (CORE_TIMER, UART1_RX, UART1_TX, UART1_ERR, I2C1_MASTER,
+ * I2C1_BUS). Times in core timer ticks (83.3 ns), 0xFFFF = not measured.
+ */
+#define MBS_IR_ISR_BASE                     0u
+#define MBS_IR_ISR_STRIDE                   4u
+#define MBS_IR_ISR_LAT_LAST                 0u                              // entry latency, last
+#define MBS_IR_ISR_LAT_MAX                  1u                              // entry latency, max
+#define MBS_IR_ISR_RUN_MAX                  2u                              // run time, max
+#define MBS_IR_ISR_COUNT                    3u                              // entries, low 16 bits
+
+/* RAM usage in bytes (linker symbols + stack paint high-water mark). DATA and BSS
+ * are approximate: the linker best-fit places .data* / .bss* input sections, not
+ * necessarily between the symbols used, see diag.h */
+#define MBS_IR_RAM_BASE                     24u
+#define MBS_IR_RAM_TOTAL                    (MBS_IR_RAM_BASE + 0u)          // kseg0_data_mem size
+#define MBS_IR_RAM_PERSIST                  (MBS_IR_RAM_BASE + 1u)          // .persist (no-init)
+#define MBS_IR_RAM_DATA                     (MBS_IR_RAM_BASE + 2u)          // initialised data, approximate: _persist_end .. _data_end
+#define MBS_IR_RAM_BSS                      (MBS_IR_RAM_BASE + 3u)          // zeroed data, approximate: _bss_begin .. _bss_end
+#define MBS_IR_RAM_STATIC_END               (MBS_IR_RAM_BASE + 4u)          // offset of _bss_end
+#define MBS_IR_RAM_HEAP                     (MBS_IR_RAM_BASE + 5u)          // _min_heap_size
+#define MBS_IR_RAM_STACK_SIZE               (MBS_IR_RAM_BASE + 6u)          // _stack - _splim
+#define MBS_IR_RAM_STACK_MAX                (MBS_IR_RAM_BASE + 7u)          // high-water mark
+#define MBS_IR_RAM_STACK_FREE               (MBS_IR_RAM_BASE + 8u)          // never touched
+#define MBS_IR_RAM_FLAGS                    (MBS_IR_RAM_BASE + 9u)          // MBS_IR_RAM_FLAG_xxx
+#define MBS_IR_RAM_FLAG_STACK_OVERFLOW      0x0001
+
+/* Reset record (supervisor.c). Task ids: SUP_TASK_ID, 0xFFFF = none */
+#define MBS_IR_RST_BASE                     34u
+#define MBS_IR_RST_RCON                     (MBS_IR_RST_BASE + 0u)          // RCON at boot
+#define MBS_IR_RST_CAUSE                    (MBS_IR_RST_BASE + 1u)          // SUP_RESET_CAUSE
+#define MBS_IR_RST_TASK                     (MBS_IR_RST_BASE + 2u)          // task that missed its deadline
+#define MBS_IR_RST_LAST_TASK                (MBS_IR_RST_BASE + 3u)          // last task check-in before reset
+#define MBS_IR_RST_AGE_MS                   (MBS_IR_RST_BASE + 4u)          // offending task: ms since check-in
+#define MBS_IR_RST_WDT_COUNT                (MBS_IR_RST_BASE + 5u)          // watchdog resets since POR
+#define MBS_IR_RST_BOOT_COUNT               (MBS_IR_RST_BASE + 6u)          // boots since POR
+
+/* Boot profile (diag.c), phase durations in us, saturated at 0xFFFF */
+#define MBS_IR_BOOT_BASE                    41u
+#define MBS_IR_BOOT_STARTUP_US              (MBS_IR_BOOT_BASE + 0u)         // reset -> main()
+#define MBS_IR_BOOT_CLOCK_US                (MBS_IR_BOOT_BASE + 1u)         // CLK_Initialize()
+#define MBS_IR_BOOT_PERIPH_US               (MBS_IR_BOOT_BASE + 2u)         // rest of SYS_Initialize()
+#define MBS_IR_BOOT_MODBUS_US               (MBS_IR_BOOT_BASE + 3u)         // -> Modbus slave live
+#define MBS_IR_BOOT_DEFERRED_US             (MBS_IR_BOOT_BASE + 4u)         // deferred init after live
+#define MBS_IR_BOOT_LIVE_US_HI              (MBS_IR_BOOT_BASE + 5u)         // reset -> live, uint32 us
+#define MBS_IR_BOOT_LIVE_US_LO              (MBS_IR_BOOT_BASE + 6u)
+#define MBS_IR_BOOT_FIRST_REQ_100MS         (MBS_IR_BOOT_BASE + 7u)         // deferred done -> first request, 100 ms periods begun (1 = < 100 ms), 0 = none yet
+
+/* TLV493D acquisition statistics, low 16 bits of the driver counters */
+#define MBS_IR_TLV_BASE                     85u
+#define MBS_IR_TLV_SAMPLES                  (MBS_IR_TLV_BASE + 0u)
+#define MBS_IR_TLV_STALE                    (MBS_IR_TLV_BASE + 1u)
+#define MBS_IR_TLV_ERRORS                   (MBS_IR_TLV_BASE + 2u)
+#define MBS_IR_TLV_OVERFLOWS                (MBS_IR_TLV_BASE + 3u)
+#define MBS_IR_TLV_RATE_HZ                  (MBS_IR_TLV_BASE + 4u)          // samples last second
+
+/* TLV493D per sensor, one block of MBS_IR_TLVS_STRIDE registers in TLV493D_ID order
+ * (horizontal, vertical, focus). Sensor 0 is also in the holding registers above. */
+#define MBS_IR_TLVS_BASE                    90u
+#define MBS_IR_TLVS_STRIDE                  3u
+#define MBS_IR_TLVS_HEADING                 0u                              // int16: centidegrees [-18000..18000]
+#define MBS_IR_TLVS_AGE                     1u                              // ms since last sample, 0xFFFF = no valid sample
+#define MBS_IR_TLVS_ADDR                    2u                              // I2C address in use, 0 = not present
+
+/* TLV493D calibration (tlv493d_cal.c) */
+#define MBS_IR_TLVCAL_BASE                  100u
+#define MBS_IR_TLVCAL_STATE                 (MBS_IR_TLVCAL_BASE + 0u)       // TLV493D_CAL_STATE
+#define MBS_IR_TLVCAL_SENSOR                (MBS_IR_TLVCAL_BASE + 1u)       // sensor of the last/current run
+#define MBS_IR_TLVCAL_SAMPLES               (MBS_IR_TLVCAL_BASE + 2u)       // samples accumulated, saturated
+#define MBS_IR_TLVCAL_SECTORS               (MBS_IR_TLVCAL_BASE + 3u)       // 16 x 22.5 deg seen, bit 0 = -180 deg
+#define MBS_IR_TLVCAL_RESULT                (MBS_IR_TLVCAL_BASE + 4u)       // TLV493D_CAL_RESULT
+#define MBS_IR_TLVCAL_STORED                (MBS_IR_TLVCAL_BASE + 5u)       // bit per sensor: coefficients in flash
+#define MBS_IR_TLVCAL_COEF                  (MBS_IR_TLVCAL_BASE + 6u)       // TLV493D_MAX_SENSORS blocks
+#define MBS_IR_TLVCAL_COEF_STRIDE           4u
+#define MBS_IR_TLVCAL_OFF_X                 0u                              // int16 LSB
+#define MBS_IR_TLVCAL_OFF_Y                 1u                              // int16 LSB
+#define MBS_IR_TLVCAL_SCALE_X               2u                              // Q14, 16384 = 1.0
+#define MBS_IR_TLVCAL_SCALE_Y               3u                              // Q14
+
+/* I2C1 bus recovery (i2cbus.c) and the TLV493D resume after it, low 16 bits of the counters */
+#define MBS_IR_I2C_BASE                     118u
+#define MBS_IR_I2C_RECOVERIES               (MBS_IR_I2C_BASE + 0u)          // bus recoveries run
+#define MBS_IR_I2C_RECOVER_FAILS            (MBS_IR_I2C_BASE + 1u)          // bus still held afterwards
+#define MBS_IR_I2C_RECOVER_CLKS             (MBS_IR_I2C_BASE + 2u)          // SCL pulses until SDA released, last run
+#define MBS_IR_I2C_RECOVER_US               (MBS_IR_I2C_BASE + 3u)          // duration of the last run
+#define MBS_IR_I2C_RECOVER_MAX_US           (MBS_IR_I2C_BASE + 4u)
+#define MBS_IR_TLV_RESUMES                  (MBS_IR_I2C_BASE + 5u)          // acquisition resumed without reinit
+#define MBS_IR_TLV_REINITS                  (MBS_IR_I2C_BASE + 6u)          // full reinit after a bus fault
+#define MBS_IR_TLV_RESUME_MS                (MBS_IR_I2C_BASE + 7u)          // recovery start -> first sample, last resume
+#define MBS_IR_TLV_RESUME_MAX_MS            (MBS_IR_I2C_BASE + 8u)
+
+/* TLV493D sample FIFO (tlv493d_fifo.c). A function 4 read that starts at
+ * MBS_IR_TLVFIFO_BASE pops as many entries as fit in the requested count and
+ * returns them oldest first; reads elsewhere have no side effect. */
+#define MBS_IR_TLVFIFO_BASE                 128u
+#define MBS_IR_TLVFIFO_FILL                 (MBS_IR_TLVFIFO_BASE + 0u)      // entries left after this read
+#define MBS_IR_TLVFIFO_OVERFLOWS            (MBS_IR_TLVFIFO_BASE + 1u)      // entries dropped, FIFO full
+#define MBS_IR_TLVFIFO_COUNT                (MBS_IR_TLVFIFO_BASE + 2u)      // entries in this read
+#define MBS_IR_TLVFIFO_SEQ                  (MBS_IR_TLVFIFO_BASE + 3u)      // sequence number of the first entry
+#define MBS_IR_TLVFIFO_ENTRY                (MBS_IR_TLVFIFO_BASE + 4u)
+#define MBS_IR_TLVFIFO_ENTRIES              19u                             // per read, fits MBS_MAX_READ_REGISTERS
+#define MBS_IR_TLVFIFO_STRIDE               5u
+#define MBS_IR_TLVFIFO_T_MS                 0u                              // low 16 bits of the read start time
+#define MBS_IR_TLVFIFO_X                    1u                              // int16 raw
+#define MBS_IR_TLVFIFO_Y                    2u
+#define MBS_IR_TLVFIFO_Z                    3u
+#define MBS_IR_TLVFIFO_TEMP_FRAME           4u                              // temp raw [15:4], sensor [3:2], frame [1:0]
+
+/* I2C1 transaction queue (i2cbus.c), low 16 bits of the counters */
+#define MBS_IR_I2CQ_BASE                    227u
+#define MBS_IR_I2CQ_XFERS                   (MBS_IR_I2CQ_BASE + 0u)         // transfers completed
+#define MBS_IR_I2CQ_ERRORS                  (MBS_IR_I2CQ_BASE + 1u)         // of those, NACK/collision/timeout/aborted
+#define MBS_IR_I2CQ_TIMEOUTS                (MBS_IR_I2CQ_BASE + 2u)
+#define MBS_IR_I2CQ_DEPTH_MAX               (MBS_IR_I2CQ_BASE + 3u)         // deepest queue seen, active included
+
+/* TLV493D field magnitude per sensor, one block of MBS_IR_TLVF_STRIDE registers in TLV493D_ID order */
+#define MBS_IR_TLVF_BASE                    232u
+#define MBS_IR_TLVF_STRIDE                  2u
+#define MBS_IR_TLVF_BMAG                    0u                              // |B| at 25 C, LSB (98 uT)
+#define MBS_IR_TLVF_FLAGS                   1u                              // TLV493D_FIELD_WEAK 0x01, _SATURATED 0x02
+
+/* Endstop event log (endstop_log.c), same read protocol as the TLV493D FIFO:
+ * a function 4 read that starts at MBS_IR_ESLOG_BASE pops the oldest events. */
+#define MBS_IR_ESLOG_BASE                   238u
+#define MBS_IR_ESLOG_FILL                   (MBS_IR_ESLOG_BASE + 0u)        // events left after this read
+#define MBS_IR_ESLOG_OVERFLOWS              (MBS_IR_ESLOG_BASE + 1u)        // events dropped, log full
+#define MBS_IR_ESLOG_COUNT                  (MBS_IR_ESLOG_BASE + 2u)        // events in this read
+#define MBS_IR_ESLOG_SEQ                    (MBS_IR_ESLOG_BASE + 3u)        // sequence number of the first event
+#define MBS_IR_ESLOG_ENTRY                  (MBS_IR_ESLOG_BASE + 4u)
+#define MBS_IR_ESLOG_ENTRIES                19u                             // per read, fits MBS_MAX_READ_REGISTERS
+#define MBS_IR_ESLOG_STRIDE                 5u
+#define MBS_IR_ESLOG_T_US_HI                0u                              // uint32 hi/lo, edge time in us since boot
+#define MBS_IR_ESLOG_T_US_LO                1u
+#define MBS_IR_ESLOG_EVENT                  2u                              // input [1:0] (endstop_id_t), 0x0010 = became active
+#define MBS_IR_ESLOG_HEADING                3u                              // int16 centidegrees, TLV493D of the axis; 0x8000 = none
+#define MBS_IR_ESLOG_CMD_POS                4u                              // int16 commanded position of the axis; 0x8000 = none
+#define MBS_IR_ESLOG_EVENT_ACTIVE           0x0010
+
+/* Endstop chatter statistics (endstop.c), since MBS_DIAG_CMD_CLEAR_ENDSTOP_STATS or boot.
+ * One block of MBS_IR_ESTAT_STRIDE registers per input in endstop_id_t order, low 16 bits of the counters. */
+#define MBS_IR_ESTAT_BASE                   337u
+#define MBS_IR_ESTAT_WINDOW_S_HI            (MBS_IR_ESTAT_BASE + 0u)        // uint32 hi/lo, seconds since the clear
+#define MBS_IR_ESTAT_WINDOW_S_LO            (MBS_IR_ESTAT_BASE + 1u)
+#define MBS_IR_ESTAT_ENTRY                  (MBS_IR_ESTAT_BASE + 2u)
+#define MBS_IR_ESTAT_STRIDE                 4u
+#define MBS_IR_ESTAT_RAW_EDGES              0u                              // pin transitions, dropped pulses included
+#define MBS_IR_ESTAT_EDGES                  1u                              // accepted by the glitch filter
+#define MBS_IR_ESTAT_GLITCHES               2u                              // pulses dropped
+#define MBS_IR_ESTAT_MIN_PULSE_US           3u                              // shortest raw pulse, 0 = below one pin read, 0xFFFF = none / longer
+
+/* Endstop input table state (endstop_cfg.c), MBS_INCFG_STATE_xxx */
+#define MBS_IR_INCFG_STATE                  99u
+
+/* GPIO port snapshots (portsnap.c), the last PORTSNAP_HISTORY newest first. Refreshed by
+ * any function 4 read that touches the block, no side effect. Unused entries are zero. */
+#define MBS_IR_PSNAP_BASE                   355u
+#define MBS_IR_PSNAP_COUNT                  (MBS_IR_PSNAP_BASE + 0u)        // valid entries
+#define MBS_IR_PSNAP_PERIOD_MS              (MBS_IR_PSNAP_BASE + 1u)        // period in use, 0 = off
+#define MBS_IR_PSNAP_ENTRY                  (MBS_IR_PSNAP_BASE + 2u)
+#define MBS_IR_PSNAP_STRIDE                 7u
+#define MBS_IR_PSNAP_SEQ                    0u                              // sequence number
+#define MBS_IR_PSNAP_T_US_HI                1u                              // uint32 hi/lo, us since boot, ENDSTOP / ESLOG clock
+#define MBS_IR_PSNAP_T_US_LO                2u
+#define MBS_IR_PSNAP_PORTA                  3u
+#define MBS_IR_PSNAP_PORTB                  4u
+#define MBS_IR_PSNAP_PORTC                  5u
+#define MBS_IR_PSNAP_PORTD                  6u
+
+/* Motor inhibit (inhibit.c), INHIBIT_SRC_xxx bit masks */
+#define MBS_IR_INH_BASE                     413u
+#define MBS_IR_INH_LATCHED                  (MBS_IR_INH_BASE + 0u)          // output held, until MBS_INHIBIT_ACK
+#define MBS_IR_INH_ACTIVE                   (MBS_IR_INH_BASE + 1u)          // condition present now
+
+/* Supply drop watch (pwrmon.c), last event */
+#define MBS_IR_PWR_BASE                     415u
+#define MBS_IR_PWR_EVENTS                   (MBS_IR_PWR_BASE + 0u)          // drops since boot
+#define MBS_IR_PWR_LOW                      (MBS_IR_PWR_BASE + 1u)          // 1 = below the limit now
+#define MBS_IR_PWR_T_US_HI                  (MBS_IR_PWR_BASE + 2u)          // uint32 hi/lo, us since boot, ENDSTOP / ESLOG clock
+#define MBS_IR_PWR_T_US_LO                  (MBS_IR_PWR_BASE + 3u)
+#define MBS_IR_PWR_MIN_MV                   (MBS_IR_PWR_BASE + 4u)          // lowest sample, supply mV
+#define MBS_IR_PWR_DURATION_MS              (MBS_IR_PWR_BASE + 5u)          // below limit + hysteresis, so far if LOW
+#define MBS_IR_INH_RELEASED                 421u                            // rule acked while active, trips again once clear
+
+/* Joystick shaping (joystick.c), every 1 ms */
+#define MBS_IR_JS_BASE                      422u
+#define MBS_IR_JS_JOG_HORIZ                 (MBS_IR_JS_BASE + 0u)           // ADM jog command word, write to driver 0x00CA
+#define MBS_IR_JS_JOG_VERT                  (MBS_IR_JS_BASE + 1u)
+#define MBS_IR_JS_FOCUS_SI                  (MBS_IR_JS_BASE + 2u)           // int16 speed
+
+/* Periodic activity before the exception (fault.c), FAULT_BEAT_COUNT entries in FAULT_BEAT order */
+#define MBS_IR_FAULT_BEAT                   425u
+#define MBS_IR_FAULT_BEAT_STRIDE            3u
+#define MBS_IR_FAULT_BEAT_COUNT             0u                              // low 16 bits, 0 = none
+#define MBS_IR_FAULT_BEAT_ARG               1u                              // of the last one
+#define MBS_IR_FAULT_BEAT_AGE_MS            2u                              // last one, ms before the exception
+
+/* Last supply drop (fault.c, pwrmon.c), survives every reset but POR */
+#define MBS_IR_FAULT_DROP_BASE              431u
+#define MBS_IR_FAULT_DROP_COUNT             (MBS_IR_FAULT_DROP_BASE + 0u)   // drops since POR, low 16 bits
+#define MBS_IR_FAULT_DROP_RESETS            (MBS_IR_FAULT_DROP_BASE + 1u)   // resets since the last drop, 0 = this run
+#define MBS_IR_FAULT_DROP_UPTIME_HI         (MBS_IR_FAULT_DROP_BASE + 2u)   // uint32 hi/lo, ms since boot of that run
+#define MBS_IR_FAULT_DROP_MIN_MV            (MBS_IR_FAULT_DROP_BASE + 4u)   // lowest supply, mV
+
+/* Post-mortem exception record (fault.c), kept until MBS_DIAG_CMD_CLEAR_FAULT */
+#define MBS_IR_FAULT_BASE                   49u
+#define MBS_IR_FAULT_VALID                  (MBS_IR_FAULT_BASE + 0u)        // 1 = record present
+#define MBS_IR_FAULT_COUNT                  (MBS_IR_FAULT_BASE + 1u)        // exceptions since POR
+#define MBS_IR_FAULT_EXCCODE                (MBS_IR_FAULT_BASE + 2u)        // CP0 Cause.ExcCode
+#define MBS_IR_FAULT_EPC_HI                 (MBS_IR_FAULT_BASE + 3u)        // uint32 hi/lo
+#define MBS_IR_FAULT_BADVADDR_HI            (MBS_IR_FAULT_BASE + 5u)        // uint32 hi/lo
+#define MBS_IR_FAULT_HANDLER_SP_HI          (MBS_IR_FAULT_BASE + 7u)        // uint32 hi/lo, $sp in the exception handler
+#define MBS_IR_FAULT_UPTIME_HI              (MBS_IR_FAULT_BASE + 9u)        // uint32 hi/lo, ms
+#define MBS_IR_FAULT_TRACE_N                (MBS_IR_FAULT_BASE + 11u)       // valid trace entries
+#define MBS_IR_FAULT_TRACE                  (MBS_IR_FAULT_BASE + 12u)       // FAULT_TRACE_LEN entries, newest first
+#define MBS_IR_FAULT_TRACE_STRIDE           3u
+#define MBS_IR_FAULT_TRACE_EV               0u                              // FAULT_EVENT
+#define MBS_IR_FAULT_TRACE_ARG              1u
+#define MBS_IR_FAULT_TRACE_AGE_MS           2u                              // ms before the exception
+
     
     /* ************************************************************************** */
     /** MBS_COMMAND bit mask Description 
@@ -218,6 +522,8 @@ extern "C" {
 #define MBS_SL_STATUS_ALARM                 0x0080    
 #define MBS_SL_STATUS_GOTO_HORIZ_ALARM      0x0100    
 #define MBS_SL_STATUS_GOTO_VERT_ALARM       0x0200    
+#define MBS_SL_STATUS_MAGNET_WEAK           0x0400      // TLV493D |B| below MBS_TLV493D_BMIN
+#define MBS_SL_STATUS_MAGNET_SATURATED      0x0800      // TLV493D |B| above MBS_TLV493D_BMAX or clipped
 #define MBS_SL_STATUS_GOTO_HORIZ_POS        0x1000    
 #define MBS_SL_STATUS_GOTO_VERT_POS         0x2000    
 #define MBS_SL_STATUS_VERT_SENSOR_FAULT     0x4000    
@@ -228,6 +534,31 @@ extern "C" {
     /** MBS_JOYSTICK_SETUP bit mask Description (0x0000 - Default R5 functionallity)
      */
 #define MBS_JS_SLAVE_ENABLED                0x0001    
+
+    
+    /* ************************************************************************** */
+    /** MBS_DIAG_COMMAND bit mask Description 
+     */
+#define MBS_DIAG_CMD_CLEAR_ISR              0x0001    
+#define MBS_DIAG_CMD_REPAINT_STACK          0x0002    
+#define MBS_DIAG_CMD_CLEAR_RESETS           0x0004    
+#define MBS_DIAG_CMD_CLEAR_FAULT            0x0008    
+#define MBS_DIAG_CMD_CLEAR_ENDSTOP_STATS    0x0010    
+
+    
+    /* ************************************************************************** */
+    /** MBS_INCFG_CMD bit mask Description 
+     */
+#define MBS_INCFG_CMD_SAVE                  0x0001      // store the table in use in flash
+#define MBS_INCFG_CMD_RELOAD                0x0002      // back to the stored table (factory if none)
+#define MBS_INCFG_CMD_DEFAULTS              0x0004      // factory table, not stored
+
+    /* ************************************************************************** */
+    /** MBS_IR_INCFG_STATE bit mask Description 
+     */
+#define MBS_INCFG_STATE_STORED              0x0001      // table in use is the one in flash
+#define MBS_INCFG_STATE_SAVE_FAILED         0x0002      // last save did not reach the flash
+#define MBS_INCFG_STATE_REFUSED             0x0004      // last register change was limited
     
     
     // *****************************************************************************
@@ -270,13 +601,17 @@ typedef struct
 
     extern uint8_t MBS_SlaveAddress;
     extern volatile uint16_t MBS_HoldRegisters[MBS_NUMBER_OF_OUTPUT_REGISTERS];
+    extern volatile uint16_t MBS_InputRegisters[MBS_NUMBER_OF_INPUT_REGISTERS];
     extern volatile uint32_t MBS_TimerValue;
+    extern uint32_t MBS_RequestCounter;
     extern uint32_t mySystemTimeOutTimer;
     
     void MBS_InitModbus(uint8_t ModbusSlaveAddress);
-    void MBS_ProcessModbus(void);
+    bool MBS_ProcessModbus(void);
     void MBS_ReciveData(uint8_t Data);
     void MBS_UART_Putch(uint8_t ch);
+    void MBS_CRC16(const uint8_t Data, uint32_t* CRC);
+    void MBS_OnReadInputRegisters(uint16_t start, uint16_t count);
 
 /* ************************************************************************** */
 /** Helper functions for 16-bit register bit manipulation
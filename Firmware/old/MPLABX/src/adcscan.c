@@ -0,0 +1,117 @@
+#include <string.h>
+#include "definitions.h"
+#include "ModbusSlave.h"
+#include "adcscan.h"
+
+#define ADC_PHYS(a)         ((uint32_t)(uintptr_t)(a) & 0x1FFFFFFFu)
+
+/* ADC1BUFn are 0x10 apart like every PIC32 SFR; the DMA cell covers
+ * one buffer per channel with the gaps, the ring keeps that layout */
+#define ADC_BUF_STRIDE      4u                                      /* words */
+#define ADC_CELL_WORDS      ((ADCSCAN_COUNT - 1u) * ADC_BUF_STRIDE + 1u)
+#define ADC_CELL_BYTES      (ADC_CELL_WORDS * 4u)
+
+/* AD1CSS: scan order is ascending AN number, same as ADCSCAN_CH */
+#define ADC_SCAN_INPUTS     (1u << 7)
+
+#define ADC_SSRC_TMR1       0x5u        /* AD1CON1.SSRC: Timer1 period match */
+#define ADC_ADCS            4u          /* TAD = 2 * ADCS * TSRC = 333 ns */
+
+/* Written by DMA only */
+static volatile uint32_t adcRing[ADCSCAN_OVERSAMPLE * ADC_CELL_WORDS] __attribute__((aligned(4)));
+
+void ADCSCAN_Init(void)
+{
+    memset((void *)adcRing, 0, sizeof(adcRing));
+
+    /* ADC: 12-bit integer, Timer1 trigger, auto-sample, scan, one interrupt request per scan */
+    AD1CON1 = 0u;
+    AD1CON2 = _AD1CON2_CSCNA_MASK | ((ADCSCAN_COUNT - 1u) << _AD1CON2_SMPI_POSITION);
+    AD1CON3 = (ADC_ADCS << _AD1CON3_ADCS_POSITION);
+    AD1CHS = 0u;
+    AD1CSS = ADC_SCAN_INPUTS;
+    AD1CON1 = _AD1CON1_MODE12_MASK | _AD1CON1_ASAM_MASK | (ADC_SSRC_TMR1 << _AD1CON1_SSRC_POSITION);
+
+    /* The CPU never takes the ADC interrupt, the DMA listens to the request */
+    EVIC_SourceDisable(INT_SOURCE_ADC);
+    EVIC_SourceStatusClear(INT_SOURCE_ADC);
+
+    /* DMA channel 0: one cell per scan, ring of ADCSCAN_OVERSAMPLE, auto re-enable */
+    DMACONSET = _DMACON_ON_MASK;
+    DCH0CON = _DCH0CON_CHAEN_MASK | (3u << _DCH0CON_CHPRI_POSITION);
+    DCH0ECON = ((uint32_t)_ADC_VECTOR << _DCH0ECON_CHSIRQ_POSITION) | _DCH0ECON_SIRQEN_MASK;
+    DCH0SSA = ADC_PHYS(&ADC1BUF0);
+    DCH0DSA = ADC_PHYS(adcRing);
+    DCH0SSIZ = ADC_CELL_BYTES;
+    DCH0DSIZ = sizeof(adcRing);
+    DCH0CSIZ = ADC_CELL_BYTES;
+    DCH0INT = _DCH0INT_CHCCIE_MASK;
+    DCH0CONSET = _DCH0CON_CHEN_MASK;
+    EVIC_SourceStatusClear(INT_SOURCE_DMA0);
+    EVIC_SourceEnable(INT_SOURCE_DMA0);
+
+    AD1CON1SET = _AD1CON1_ON_MASK;
+
+    /* Timer1 from PBCLK, 1:1 */
+    T1CON = 0u;
+    TMR1 = 0u;
+    PR1 = (CPU_CLOCK_FREQUENCY / ADCSCAN_TRIGGER_HZ) - 1u;
+    T1CONSET = _T1CON_ON_MASK;
+}
+
+uint16_t ADCSCAN_Get(ADCSCAN_CH ch)
+{
+    const volatile uint32_t *p;
+    uint32_t sum = 0u;
+
+    if (ch >= ADCSCAN_COUNT) return 0u;
+    p = &adcRing[(uint32_t)ch * ADC_BUF_STRIDE];
+
+    /* Single word reads; a scan the DMA is writing mixes in one newer value */
+    for (uint32_t i = 0u; i < ADCSCAN_OVERSAMPLE; i++) {
+        sum += p[i * ADC_CELL_WORDS] & 0x0FFFu;
+    }
+    return (uint16_t)(sum / (ADCSCAN_OVERSAMPLE / 4u));
+}
+
+uint16_t ADCSCAN_ToPinMv(uint16_t counts)
+{
+    return (uint16_t)(((uint32_t)counts * ADCSCAN_VREF_MV + 8190u) / 16380u);
+}
+
+uint16_t ADCSCAN_ToSupplyMv(uint16_t counts)
+{
+    const uint32_t mv = ((uint32_t)ADCSCAN_ToPinMv(counts) * ADCSCAN_POWER_IN_DIV_X100 + 50u) / 100u;
+
+    return (uint16_t)((mv > 0xFFFFu) ? 0xFFFFu : mv);
+}
+
+uint16_t ADCSCAN_SupplyMvToCounts(uint16_t mv)
+{
+    const uint32_t c = ((uint32_t)mv * 100u * 4095u) / ((uint32_t)ADCSCAN_POWER_IN_DIV_X100 * ADCSCAN_VREF_MV);
+
+    return (uint16_t)((c > 4095u) ? 4095u : c);
+}
+
+void ADCSCAN_DMA_InterruptHandler(void)
+{
+    const volatile uint32_t *buf = &ADC1BUF0;
+    uint16_t v[ADCSCAN_COUNT];
+
+    DCH0INTCLR = _DCH0INT_CHCCIF_MASK;
+    EVIC_SourceStatusClear(INT_SOURCE_DMA0);
+
+    /* Still the scan the DMA just moved; the next result is one trigger period away */
+    for (uint32_t i = 0u; i < ADCSCAN_COUNT; i++) v[i] = (uint16_t)(buf[i * ADC_BUF_STRIDE] & 0x0FFFu);
+    ADCSCAN_OnScan(v);
+}
+
+void __attribute__((weak)) ADCSCAN_OnScan(const uint16_t *v)
+{
+    (void)v;
+}
+
+void ADCSCAN_Task_10ms(void)
+{
+    MBS_HoldRegisters[MBS_POWER_IN_V] = ADCSCAN_ToSupplyMv(ADCSCAN_Get(ADCSCAN_POWER_IN));
+}
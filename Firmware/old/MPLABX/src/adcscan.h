@@ -0,0 +1,73 @@
+#ifndef ADCSCAN_H
+#define ADCSCAN_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* =========================================================================
+ * Background ADC scan: supply voltage
+ *
+ * Timer1 triggers the conversions, ADCSCAN_SCAN_HZ per channel. The ADC
+ * scans the ADCSCAN_CH inputs in turn (AD1CSS). After the last one its
+ * interrupt request moves the result buffers into a RAM ring of
+ * ADCSCAN_OVERSAMPLE scans by DMA channel 0. The channel re-arms itself
+ * at the end of the ring. The CPU only sees the DMA0 cell interrupt,
+ * once per scan, for ADCSCAN_OnScan().
+ *
+ * ADCSCAN_Task_10ms() sums the ring per channel: the mean of the last
+ * ADCSCAN_OVERSAMPLE scans, 2 extra bits of resolution. It publishes
+ * the result in engineering units to MBS_POWER_IN_V. The cost is per
+ * publish, not per conversion.
+ *
+ * Only pins that are analog in the MCC pin setup are scanned. The
+ * register map also names MD_FOCUS_FB (AN4), MD_VERT_FB (AN5),
+ * MD_HORIZ_FB (AN6) and FOCUS_POS (AN18); they join the scan, and
+ * MBS_MD_xxx_FB / MBS_FOCUS_POS_RAW get published, once those pins are
+ * configured there.
+ * ========================================================================= */
+typedef enum {
+    ADCSCAN_POWER_IN = 0,       /* AN7, RB4 POWER_IN_V_FB */
+    ADCSCAN_COUNT
+} ADCSCAN_CH;
+
+#define ADCSCAN_SCAN_HZ         2000u   /* scans/s, one sample per channel */
+#define ADCSCAN_TRIGGER_HZ      (ADCSCAN_SCAN_HZ * ADCSCAN_COUNT)   /* conversions/s */
+#define ADCSCAN_OVERSAMPLE      16u     /* scans averaged, 8 ms */
+#define ADCSCAN_VREF_MV         3300u   /* AVDD reference */
+
+/* Supply divider on POWER_IN_V_FB, ratio x100 (e.g. 100k / 10k = 1100) */
+#ifndef ADCSCAN_POWER_IN_DIV_X100
+#define ADCSCAN_POWER_IN_DIV_X100   1100u
+#endif
+
+/** Timer1, ADC and DMA channel 0. Call once at boot; runs on its own from here. */
+void ADCSCAN_Init(void);
+
+/**
+ * Mean of the last ADCSCAN_OVERSAMPLE conversions of one channel, 12-bit
+ * counts scaled by 4 (0..16380). Main loop.
+ */
+uint16_t ADCSCAN_Get(ADCSCAN_CH ch);
+
+/** Counts from ADCSCAN_Get() to mV at the pin. */
+uint16_t ADCSCAN_ToPinMv(uint16_t counts);
+
+/** Counts from ADCSCAN_Get() to mV of the supply, saturated. */
+uint16_t ADCSCAN_ToSupplyMv(uint16_t counts);
+
+/** Supply in mV to one 12-bit AN7 sample (0..4095), as seen by ADCSCAN_OnScan(). */
+uint16_t ADCSCAN_SupplyMvToCounts(uint16_t mv);
+
+/** DMA0 interrupt (IPL4), once per scan. */
+void ADCSCAN_DMA_InterruptHandler(void);
+
+/**
+ * Hook with the newest scan, 12-bit counts in ADCSCAN_CH order, weak
+ * default does nothing. DMA0 ISR, keep it short.
+ */
+void ADCSCAN_OnScan(const uint16_t *v);
+
+/** Publish all channels to the holding registers. Call at 10 ms cadence. */
+void ADCSCAN_Task_10ms(void);
+
+#endif /* ADCSCAN_H */
@@ -47,6 +47,7 @@
 // *****************************************************************************
 #include "device.h"
 #include "definitions.h"
+#include "fault.h"
 #include <stdio.h>
 
 // *****************************************************************************
@@ -98,6 +99,13 @@ static unsigned int exception_address;
 /* Code identifying the cause of the exception (CP0 Cause register). */
 static uint32_t  exception_code;
 
+/* Full CP0 Cause, BadVAddr and the handler's own stack pointer for the post-mortem
+ * record (fault.c). The faulting code's SP is above it by the context frame of the
+ * XC32 exception entry and this handler's frame; it is not saved anywhere we can read. */
+static uint32_t  exception_cause;
+static uint32_t  exception_badvaddr;
+static uint32_t  exception_handler_sp;
+
 
 // </editor-fold>
 
@@ -120,12 +128,16 @@ void __attribute__((noreturn, weak)) _general_exception_handler ( void )
     exception_code = ((_CP0_GET_CAUSE() & 0x0000007CU) >> 2U);
     exception_address = _CP0_GET_EPC();
 
-    while (true)
-    {
-        #if defined(__DEBUG) || defined(__DEBUG_D) && defined(__XC32)
-            __builtin_software_breakpoint();
-        #endif
-    }
+    exception_cause = _CP0_GET_CAUSE();
+    exception_badvaddr = _CP0_GET_BADVADDR();
+    __asm__ volatile ("move %0, $sp" : "=r" (exception_handler_sp));
+
+    #if defined(__DEBUG) || defined(__DEBUG_D) && defined(__XC32)
+        __builtin_software_breakpoint();
+    #endif
+
+    /* Store post-mortem record and reset */
+    FAULT_Capture(exception_cause, exception_address, exception_badvaddr, exception_handler_sp);
 }
 /*******************************************************************************
   Function:
@@ -146,12 +158,16 @@ void __attribute__((noreturn, weak)) _bootstrap_exception_handler(void)
     exception_code = (_CP0_GET_CAUSE() & 0x0000007CU) >> 2U;
     exception_address = _CP0_GET_EPC();
 
-    while (true)
-    {
-        #if defined(__DEBUG) || defined(__DEBUG_D) && defined(__XC32)
-            __builtin_software_breakpoint();
-        #endif
-    }
+    exception_cause = _CP0_GET_CAUSE();
+    exception_badvaddr = _CP0_GET_BADVADDR();
+    __asm__ volatile ("move %0, $sp" : "=r" (exception_handler_sp));
+
+    #if defined(__DEBUG) || defined(__DEBUG_D) && defined(__XC32)
+        __builtin_software_breakpoint();
+    #endif
+
+    /* Store post-mortem record and reset */
+    FAULT_Capture(exception_cause, exception_address, exception_badvaddr, exception_handler_sp);
 }
 /*******************************************************************************
  End of File
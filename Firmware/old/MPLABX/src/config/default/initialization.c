@@ -44,8 +44,12 @@
 // *****************************************************************************
 // *****************************************************************************
 #include "definitions.h"
+#include "diag.h"
 #include "device.h"
 
+/* SYS_Initialize() marks DIAG_BOOT_CLOCK, RWDTPS is set for the supervisor */
+const uint8_t DIAG_BootClockMarked = 1u;
+
 
 // ****************************************************************************
 // ****************************************************************************
@@ -74,7 +78,7 @@
 #pragma config SWDTPS =      PS524288
 #pragma config FWDTWINSZ =  PS25_0
 #pragma config WINDIS =     OFF
-#pragma config RWDTPS =      PS1048576
+#pragma config RWDTPS =      PS4096         /* ~128 ms, enabled by SUP_Start() */
 #pragma config RCLKSEL =     LPRC
 #pragma config FWDTEN =     OFF
 
@@ -158,6 +162,7 @@ void SYS_Initialize ( void* data )
 
   
     CLK_Initialize();
+    DIAG_BootMark(DIAG_BOOT_CLOCK);
 
 
 	GPIO_Initialize();
@@ -50,6 +50,8 @@
 // *****************************************************************************
 #include "interrupts.h"
 #include "definitions.h"
+#include "diag.h"
+#include "irqplan.h"
 
 
 
@@ -79,34 +81,49 @@ void I2C1_BUS_Handler (void);
 // Section: System Interrupt Vector definitions
 // *****************************************************************************
 // *****************************************************************************
-void __attribute__((used)) __ISR(_CORE_TIMER_VECTOR, ipl1SOFT) CORE_TIMER_Handler (void)
+/* Levels follow irqplan.h, not the MCC priorities */
+const uint8_t IRQPLAN_IsrLevels = 1u;
+
+void __attribute__((used)) __ISR(_CORE_TIMER_VECTOR, ipl2SOFT) CORE_TIMER_Handler (void)
 {
+    DIAG_IsrEnter(DIAG_ISR_CORE_TIMER, _CP0_GET_COMPARE());
     CORE_TIMER_InterruptHandler();
+    DIAG_IsrExit(DIAG_ISR_CORE_TIMER);
 }
 
-void __attribute__((used)) __ISR(_UART1_RX_VECTOR, ipl1SOFT) UART1_RX_Handler (void)
+void __attribute__((used)) __ISR(_UART1_RX_VECTOR, ipl7SRS) UART1_RX_Handler (void)
 {
+    DIAG_IsrEnter(DIAG_ISR_UART1_RX, 0u);
     UART1_RX_InterruptHandler();
+    DIAG_IsrExit(DIAG_ISR_UART1_RX);
 }
 
-void __attribute__((used)) __ISR(_UART1_TX_VECTOR, ipl1SOFT) UART1_TX_Handler (void)
+void __attribute__((used)) __ISR(_UART1_TX_VECTOR, ipl5SOFT) UART1_TX_Handler (void)
 {
+    DIAG_IsrEnter(DIAG_ISR_UART1_TX, 0u);
     UART1_TX_InterruptHandler();
+    DIAG_IsrExit(DIAG_ISR_UART1_TX);
 }
 
-void __attribute__((used)) __ISR(_UART1_ERR_VECTOR, ipl1SOFT) UART1_ERR_Handler (void)
+void __attribute__((used)) __ISR(_UART1_ERR_VECTOR, ipl6SOFT) UART1_ERR_Handler (void)
 {
+    DIAG_IsrEnter(DIAG_ISR_UART1_ERR, 0u);
     UART1_ERR_InterruptHandler();
+    DIAG_IsrExit(DIAG_ISR_UART1_ERR);
 }
 
-void __attribute__((used)) __ISR(_I2C1_MASTER_VECTOR, ipl1SOFT) I2C1_MASTER_Handler (void)
+void __attribute__((used)) __ISR(_I2C1_MASTER_VECTOR, ipl3SOFT) I2C1_MASTER_Handler (void)
 {
+    DIAG_IsrEnter(DIAG_ISR_I2C1_MASTER, 0u);
     I2C1_MASTER_InterruptHandler();
+    DIAG_IsrExit(DIAG_ISR_I2C1_MASTER);
 }
 
-void __attribute__((used)) __ISR(_I2C1_BUS_VECTOR, ipl1SOFT) I2C1_BUS_Handler (void)
+void __attribute__((used)) __ISR(_I2C1_BUS_VECTOR, ipl3SOFT) I2C1_BUS_Handler (void)
 {
+    DIAG_IsrEnter(DIAG_ISR_I2C1_BUS, 0u);
     I2C1_BUS_InterruptHandler();
+    DIAG_IsrExit(DIAG_ISR_I2C1_BUS);
 }
 
 
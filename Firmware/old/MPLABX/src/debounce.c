@@ -0,0 +1,56 @@
+#include "debounce.h"
+
+void DEBOUNCE_Init(DEBOUNCE_t *d, uint32_t raw, uint32_t mask)
+{
+    d->state = raw;
+    d->mask = mask;
+    for (uint8_t k = 0u; k < DEBOUNCE_PLANES; k++) {
+        d->cnt[k] = 0u;
+        d->len[k] = (k == 0u) ? 0xFFFFFFFFu : 0u;
+    }
+}
+
+void DEBOUNCE_SetLength(DEBOUNCE_t *d, uint32_t inputs, uint8_t samples)
+{
+    if (samples == 0u) samples = 1u;
+    if (samples > DEBOUNCE_LEN_MAX) samples = DEBOUNCE_LEN_MAX;
+
+    for (uint8_t k = 0u; k < DEBOUNCE_PLANES; k++) {
+        if (samples & (1u << k)) d->len[k] |= inputs;
+        else                     d->len[k] &= ~inputs;
+    }
+}
+
+uint8_t DEBOUNCE_GetLength(const DEBOUNCE_t *d, uint8_t bit)
+{
+    uint8_t n = 0u;
+
+    for (uint8_t k = 0u; k < DEBOUNCE_PLANES; k++) {
+        n |= (uint8_t)(((d->len[k] >> bit) & 1u) << k);
+    }
+    return n;
+}
+
+uint32_t DEBOUNCE_Run(DEBOUNCE_t *d, uint32_t raw)
+{
+    uint32_t delta = (raw ^ d->state) & d->mask;    /* differs from the debounced level */
+    uint32_t carry = delta;
+    uint32_t done = delta;
+
+    /* cnt = delta ? cnt + 1 : 0, ripple carry across the planes; done = (cnt == len) */
+    for (uint8_t k = 0u; k < DEBOUNCE_PLANES; k++) {
+        uint32_t c = d->cnt[k];
+        uint32_t n = (c ^ carry) & delta;
+
+        carry &= c;
+        d->cnt[k] = n;
+        done &= ~(n ^ d->len[k]);
+    }
+
+    /* Accepted inputs flip and start counting from zero again */
+    for (uint8_t k = 0u; k < DEBOUNCE_PLANES; k++) {
+        d->cnt[k] &= ~done;
+    }
+    d->state = ((d->state ^ done) & d->mask) | (raw & ~d->mask);
+    return done;
+}
@@ -0,0 +1,44 @@
+#ifndef DEBOUNCE_H
+#define DEBOUNCE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* =========================================================================
+ * Vertical counter debounce, 32 inputs per word
+ *
+ * Every input has a DEBOUNCE_PLANES bit counter, stored bit-sliced: plane k
+ * holds bit k of all 32 counters. One DEBOUNCE_Run() per sample counts up
+ * the inputs that differ from their debounced state and clears the rest,
+ * with a handful of word operations per plane. The cost is the same for
+ * 1 or 32 inputs; no branch depends on the input data.
+ *
+ * An input takes its new level after 'length' consecutive samples at that
+ * level (1..DEBOUNCE_LEN_MAX, set per input). The lengths are bit-sliced
+ * the same way, so the compare is bitwise too.
+ *
+ * No dependencies, the same file builds on the host.
+ * ========================================================================= */
+#define DEBOUNCE_PLANES         5u
+#define DEBOUNCE_LEN_MAX        ((1u << DEBOUNCE_PLANES) - 1u)     /* 31 samples */
+
+typedef struct
+{
+    uint32_t state;                     /* debounced levels */
+    uint32_t mask;                      /* inputs debounced; others follow raw, no change reported */
+    uint32_t cnt[DEBOUNCE_PLANES];      /* bit-sliced counters */
+    uint32_t len[DEBOUNCE_PLANES];      /* bit-sliced lengths */
+} DEBOUNCE_t;
+
+/** Start at 'raw' with nothing pending. Lengths are set to 1. */
+void DEBOUNCE_Init(DEBOUNCE_t *d, uint32_t raw, uint32_t mask);
+
+/** Samples a new level must be seen for, for every input in 'inputs'. 0 counts as 1. */
+void DEBOUNCE_SetLength(DEBOUNCE_t *d, uint32_t inputs, uint8_t samples);
+
+uint8_t DEBOUNCE_GetLength(const DEBOUNCE_t *d, uint8_t bit);
+
+/** One sample. Returns the inputs whose debounced level changed. */
+uint32_t DEBOUNCE_Run(DEBOUNCE_t *d, uint32_t raw);
+
+#endif /* DEBOUNCE_H */
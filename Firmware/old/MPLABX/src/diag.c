@@ -0,0 +1,215 @@
+#include "definitions.h"
+#include "ModbusSlave.h"
+#include "diag.h"
+
+extern volatile uint32_t myTime;                /* main.c, 1 ms tick */
+
+/* ===================== Constants ===================== */
+#define DIAG_PROBE_TIMEOUT_TICKS    (CORE_TIMER_FREQUENCY / 1000u)  /* 1 ms */
+#define DIAG_RAM_BASE               0x80000000u     /* kseg0_data_mem */
+#define DIAG_RAM_SIZE               0x8000u         /* 32 KB */
+#define DIAG_STACK_MARGIN           64u             /* bytes left unpainted below SP */
+#define DIAG_BOOT_RESET_COUNT_HZ    (8000000u / 2u) /* FRC 8 MHz, FRCDIV 1:1 */
+
+/* ===================== Linker symbols ===================== */
+extern uint32_t _persist_begin[], _persist_end[];
+extern uint32_t _data_end[], _bss_begin[], _bss_end[];
+extern uint32_t _splim[], _stack[];
+extern char _min_heap_size[];                       /* --defsym, value is the address */
+
+/* ===================== ISR statistics ===================== */
+volatile DIAG_ISR_STAT DIAG_IsrStat[DIAG_ISR_COUNT];
+
+static uint8_t diagProbeNext = 0u;
+
+/* ===================== Boot profile ===================== */
+static uint32_t diagBootUs[DIAG_BOOT_COUNT];
+static uint32_t diagBootPrev;
+static uint32_t diagBootDeferredMs;                 /* myTime at the DEFERRED mark */
+static uint16_t diagBootFirstReq;                   /* MBS_IR_BOOT_FIRST_REQ_100MS */
+
+/* ===================== Stack ===================== */
+static volatile uint32_t *diagStackMark;            /* lowest overwritten word seen */
+static bool diagStackOverflow;
+
+void DIAG_IsrClear(void)
+{
+    for (unsigned i = 0u; i < (unsigned)DIAG_ISR_COUNT; i++) {
+        DIAG_IsrStat[i].count = 0u;
+        DIAG_IsrStat[i].refT = 0u;
+        DIAG_IsrStat[i].latLast = DIAG_ISR_NOT_MEASURED;
+        DIAG_IsrStat[i].latMax = 0u;
+        DIAG_IsrStat[i].runLast = 0u;
+        DIAG_IsrStat[i].runMax = 0u;
+    }
+}
+
+void DIAG_BootMark(DIAG_BOOT_PHASE phase)
+{
+    uint32_t now = _CP0_GET_COUNT();
+    uint32_t hz = (phase <= DIAG_BOOT_CLOCK) ? DIAG_BOOT_RESET_COUNT_HZ : CORE_TIMER_FREQUENCY;
+
+    /* Up to the host, may take minutes: the count wraps after ~358 s */
+    if (phase == DIAG_BOOT_FIRST_REQUEST) {
+        diagBootFirstReq = DIAG_Sat16((myTime - diagBootDeferredMs) / 100u + 1u);
+        return;
+    }
+    if (phase == DIAG_BOOT_DEFERRED) diagBootDeferredMs = myTime;
+
+    diagBootUs[phase] = (now - diagBootPrev) / (hz / 1000000u);
+
+    if ((IEC0 & _IEC0_CTIE_MASK) == 0u) {
+        /* Core timer not started yet: restart the count for the next phase.
+         * CORETIMER_Start() clears it again, which matches diagBootPrev = 0. */
+        _CP0_SET_COUNT(0u);
+        _CP0_SET_CAUSE(_CP0_GET_CAUSE() & ~_CP0_CAUSE_DC_MASK);
+        diagBootPrev = 0u;
+    } else {
+        diagBootPrev = now;
+    }
+}
+
+void DIAG_StackPaint(void)
+{
+    volatile uint32_t *p = (volatile uint32_t *)_splim;
+    volatile uint32_t *top = (volatile uint32_t *)((uintptr_t)__builtin_frame_address(0) - DIAG_STACK_MARGIN);
+
+    while (p < top) {
+        *p++ = DIAG_STACK_PAINT;
+    }
+    diagStackMark = top;
+    diagStackOverflow = false;
+}
+
+void DIAG_StackScan(void)
+{
+    volatile uint32_t *p = (volatile uint32_t *)_splim;
+    volatile uint32_t *mark = diagStackMark;
+
+    /* Bottom word gone: the stack has reached _splim (or beyond) */
+    if (*p != DIAG_STACK_PAINT) diagStackOverflow = true;
+
+    while ((p < mark) && (*p == DIAG_STACK_PAINT)) p++;
+    diagStackMark = p;
+}
+
+void DIAG_Init(void)
+{
+    /* Unresolved once MCC has regenerated initialization.c */
+    (void)*(const volatile uint8_t *)&DIAG_BootClockMarked;
+
+    diagProbeNext = 0u;
+    DIAG_IsrClear();
+    DIAG_StackPaint();
+}
+
+void DIAG_IsrProbe(void)
+{
+    DIAG_ISR_ID id = (DIAG_ISR_ID)diagProbeNext;
+    INT_SOURCE src;
+    bool idle;
+
+    if (++diagProbeNext >= (uint8_t)DIAG_ISR_COUNT) diagProbeNext = 0u;
+
+    /*
+     * Only vectors whose handler tolerates an empty entry:
+     *  - UART1_RX: reads the FIFO until empty
+     *  - UART1_TX: no pending bytes -> disables itself
+     *  - I2C1_MASTER: state IDLE -> default case
+     */
+    switch (id) {
+        case DIAG_ISR_UART1_RX:
+            src = INT_SOURCE_UART1_RX;
+            break;
+        case DIAG_ISR_UART1_TX:
+            src = INT_SOURCE_UART1_TX;
+            break;
+        case DIAG_ISR_I2C1_MASTER:
+            src = INT_SOURCE_I2C1_MASTER;
+            break;
+        default:
+            return;
+    }
+
+    volatile DIAG_ISR_STAT *s = &DIAG_IsrStat[id];
+    bool wasEnabled = EVIC_SourceIsEnabled(src);
+
+    /* Idle check and pend must be atomic: the core timer ISR may start an
+     * I2C1 read (TLV493D stream). */
+    bool irq = EVIC_INT_Disable();
+
+    if (id == DIAG_ISR_UART1_TX) idle = (UART1_WriteCountGet() == 0u);
+    else if (id == DIAG_ISR_I2C1_MASTER) idle = !I2C1_IsBusy();
+    else idle = true;
+
+    if (!idle) {
+        EVIC_INT_Restore(irq);
+        return;
+    }
+
+    uint32_t t0 = _CP0_GET_COUNT();
+
+    EVIC_SourceEnable(src);
+    s->refT = (t0 != 0u) ? t0 : 1u;
+    EVIC_SourceStatusSet(src);
+    EVIC_INT_Restore(irq);
+
+    /* The vector is taken within a few instructions; wait for the wrapper
+     * to consume the reference before restoring the enable bit. */
+    while ((s->refT != 0u) && ((uint32_t)(_CP0_GET_COUNT() - t0) < DIAG_PROBE_TIMEOUT_TICKS)) {
+    }
+    s->refT = 0u;
+
+    if (!wasEnabled) EVIC_SourceDisable(src);
+}
+
+void DIAG_Task_250ms(void)
+{
+    uint16_t cmd = MBS_HoldRegisters[MBS_DIAG_COMMAND];
+    uint16_t done = cmd & (MBS_DIAG_CMD_CLEAR_ISR | MBS_DIAG_CMD_REPAINT_STACK);
+
+    if (done != 0u) {
+        if (MBS_RegIsBitsSet(cmd, MBS_DIAG_CMD_CLEAR_ISR)) DIAG_IsrClear();
+        if (MBS_RegIsBitsSet(cmd, MBS_DIAG_CMD_REPAINT_STACK)) DIAG_StackPaint();
+        MBS_RegClearBits(&MBS_HoldRegisters[MBS_DIAG_COMMAND], done);
+    }
+
+    for (unsigned i = 0u; i < (unsigned)DIAG_ISR_COUNT; i++) {
+        volatile uint16_t *r = &MBS_InputRegisters[MBS_IR_ISR_BASE + i * MBS_IR_ISR_STRIDE];
+
+        r[MBS_IR_ISR_LAT_LAST] = DIAG_IsrStat[i].latLast;
+        r[MBS_IR_ISR_LAT_MAX]  = DIAG_IsrStat[i].latMax;
+        r[MBS_IR_ISR_RUN_MAX]  = DIAG_IsrStat[i].runMax;
+        r[MBS_IR_ISR_COUNT]    = (uint16_t)DIAG_IsrStat[i].count;
+    }
+
+    /* RAM breakdown, bytes; DATA and BSS approximate (diag.h) */
+    uint32_t stackTop = (uint32_t)(uintptr_t)_stack;
+    uint32_t stackLim = (uint32_t)(uintptr_t)_splim;
+    uint32_t mark = (uint32_t)(uintptr_t)diagStackMark;
+
+    MBS_InputRegisters[MBS_IR_RAM_TOTAL]      = DIAG_Sat16(DIAG_RAM_SIZE);
+    MBS_InputRegisters[MBS_IR_RAM_PERSIST]    = DIAG_Sat16((uint32_t)((uintptr_t)_persist_end - (uintptr_t)_persist_begin));
+    MBS_InputRegisters[MBS_IR_RAM_DATA]       = DIAG_Sat16((uint32_t)((uintptr_t)_data_end - (uintptr_t)_persist_end));
+    MBS_InputRegisters[MBS_IR_RAM_BSS]        = DIAG_Sat16((uint32_t)((uintptr_t)_bss_end - (uintptr_t)_bss_begin));
+    MBS_InputRegisters[MBS_IR_RAM_STATIC_END] = DIAG_Sat16((uint32_t)((uintptr_t)_bss_end - DIAG_RAM_BASE));
+    MBS_InputRegisters[MBS_IR_RAM_HEAP]       = DIAG_Sat16((uint32_t)(uintptr_t)_min_heap_size);
+    MBS_InputRegisters[MBS_IR_RAM_STACK_SIZE] = DIAG_Sat16(stackTop - stackLim);
+    MBS_InputRegisters[MBS_IR_RAM_STACK_MAX]  = DIAG_Sat16(stackTop - mark);
+    MBS_InputRegisters[MBS_IR_RAM_STACK_FREE] = DIAG_Sat16(mark - stackLim);
+    MBS_InputRegisters[MBS_IR_RAM_FLAGS]      = diagStackOverflow ? MBS_IR_RAM_FLAG_STACK_OVERFLOW : 0u;
+
+    /* Boot profile */
+    uint32_t liveUs = 0u;
+
+    for (unsigned i = 0u; i <= (unsigned)DIAG_BOOT_MODBUS; i++) liveUs += diagBootUs[i];
+
+    MBS_InputRegisters[MBS_IR_BOOT_STARTUP_US]      = DIAG_Sat16(diagBootUs[DIAG_BOOT_STARTUP]);
+    MBS_InputRegisters[MBS_IR_BOOT_CLOCK_US]        = DIAG_Sat16(diagBootUs[DIAG_BOOT_CLOCK]);
+    MBS_InputRegisters[MBS_IR_BOOT_PERIPH_US]       = DIAG_Sat16(diagBootUs[DIAG_BOOT_PERIPH]);
+    MBS_InputRegisters[MBS_IR_BOOT_MODBUS_US]       = DIAG_Sat16(diagBootUs[DIAG_BOOT_MODBUS]);
+    MBS_InputRegisters[MBS_IR_BOOT_DEFERRED_US]     = DIAG_Sat16(diagBootUs[DIAG_BOOT_DEFERRED]);
+    MBS_InputRegisters[MBS_IR_BOOT_LIVE_US_HI]      = (uint16_t)(liveUs >> 16);
+    MBS_InputRegisters[MBS_IR_BOOT_LIVE_US_LO]      = (uint16_t)liveUs;
+    MBS_InputRegisters[MBS_IR_BOOT_FIRST_REQ_100MS] = diagBootFirstReq;
+}
@@ -0,0 +1,159 @@
+#ifndef DIAG_H
+#define DIAG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "device.h"
+
+/* =========================================================================
+ * Runtime diagnostics
+ *
+ * ISR statistics per interrupt vector:
+ *  - entry latency: time from the interrupt request until the first line of
+ *    the vector wrapper in interrupts.c (hardware sync + context save +
+ *    blocking by higher priority ISRs / interrupt-disabled sections)
+ *  - run time: wall time spent in the wrapper (incl. preemption)
+ *
+ * All times are core timer ticks (CORE_TIMER_FREQUENCY 12 MHz, 1 tick = 83.3 ns).
+ *
+ * Stack / RAM usage:
+ *  - the free part of the stack region (_splim .. current SP) is painted with
+ *    DIAG_STACK_PAINT at boot
+ *  - DIAG_StackScan() finds the lowest overwritten word (high-water mark)
+ *  - the static RAM breakdown is taken from the linker symbols. DATA and
+ *    BSS are approximate: the script has no bounds for the .data* / .bss*
+ *    input sections, which the best-fit allocator may place outside
+ *    _persist_end.._data_end and _bss_begin.._bss_end. The map file has
+ *    the exact figures.
+ *
+ * Boot profile:
+ *  - DIAG_BootMark() closes a boot phase and stores its duration in us.
+ *    Until CORETIMER_Start() the core timer count is restarted at every
+ *    mark; STARTUP and CLOCK run on FRC (count = 4 MHz), later phases on
+ *    SPLL (count = CORE_TIMER_FREQUENCY)
+ *  - STARTUP relies on crt0 clearing Count at reset
+ *  - PERIPH misses the few us between CORETIMER_Initialize() (stops the
+ *    count) and the end of SYS_Initialize()
+ *  - FIRST_REQUEST waits for the host and is taken from the 1 ms tick
+ *    (myTime) instead, published in 100 ms units (up to ~109 min)
+ *
+ * Latency reference per vector:
+ *  - CORE_TIMER: the COMPARE value that raised the interrupt (every tick)
+ *  - UART1_RX/TX, I2C1_MASTER: software probe from DIAG_IsrProbe(),
+ *    which pends the vector when the driver is idle
+ *  - UART1_ERR, I2C1_BUS: not probed (the handlers overwrite the driver
+ *    error state), run time only
+ * ========================================================================= */
+typedef enum {
+    DIAG_ISR_CORE_TIMER = 0,
+    DIAG_ISR_UART1_RX,
+    DIAG_ISR_UART1_TX,
+    DIAG_ISR_UART1_ERR,
+    DIAG_ISR_I2C1_MASTER,
+    DIAG_ISR_I2C1_BUS,
+    DIAG_ISR_COUNT
+} DIAG_ISR_ID;
+
+#define DIAG_ISR_NOT_MEASURED   0xFFFFu
+
+typedef struct {
+    uint32_t count;     /* number of entries */
+    uint32_t entryT;    /* core timer at last entry */
+    uint32_t refT;      /* pending probe reference, 0 = none */
+    uint16_t latLast;   /* DIAG_ISR_NOT_MEASURED until first measurement */
+    uint16_t latMax;
+    uint16_t runLast;
+    uint16_t runMax;
+} DIAG_ISR_STAT;
+
+extern volatile DIAG_ISR_STAT DIAG_IsrStat[DIAG_ISR_COUNT];
+
+static inline uint16_t DIAG_Sat16(uint32_t v)
+{
+    return (v > 0xFFFFu) ? 0xFFFFu : (uint16_t)v;
+}
+
+/* First statement in a vector wrapper.
+ * ref = core timer value when the request was raised, 0 = use pending probe. */
+static inline void DIAG_IsrEnter(DIAG_ISR_ID id, uint32_t ref)
+{
+    volatile DIAG_ISR_STAT *s = &DIAG_IsrStat[id];
+    uint32_t now = _CP0_GET_COUNT();
+
+    s->entryT = now;
+    s->count++;
+
+    if (ref == 0u) {
+        ref = s->refT;
+        s->refT = 0u;
+    }
+    if (ref != 0u) {
+        uint16_t lat = DIAG_Sat16(now - ref);
+        s->latLast = lat;
+        if (s->latMax < lat) s->latMax = lat;
+    }
+}
+
+/* Last statement in a vector wrapper */
+static inline void DIAG_IsrExit(DIAG_ISR_ID id)
+{
+    volatile DIAG_ISR_STAT *s = &DIAG_IsrStat[id];
+    uint16_t run = DIAG_Sat16(_CP0_GET_COUNT() - s->entryT);
+
+    s->runLast = run;
+    if (s->runMax < run) s->runMax = run;
+}
+
+typedef enum {
+    DIAG_BOOT_STARTUP = 0,      /* reset -> main() (crt0 data init) */
+    DIAG_BOOT_CLOCK,            /* CLK_Initialize(), SPLL lock */
+    DIAG_BOOT_PERIPH,           /* rest of SYS_Initialize(), DIAG_Init() */
+    DIAG_BOOT_MODBUS,           /* ENDSTOP / Modbus init -> CORETIMER_Start() */
+    DIAG_BOOT_DEFERRED,         /* first loop pass + deferred init */
+    DIAG_BOOT_FIRST_REQUEST,    /* -> first Modbus request addressed to us */
+    DIAG_BOOT_COUNT
+} DIAG_BOOT_PHASE;
+
+/** Close a boot phase. Each phase is marked once, in enum order. */
+void DIAG_BootMark(DIAG_BOOT_PHASE phase);
+
+/* Defined in initialization.c next to the DIAG_BOOT_CLOCK mark (and the
+ * RWDTPS config bits). An MCC regeneration drops it, and the link fails
+ * instead of merging CLOCK into PERIPH. */
+extern const uint8_t DIAG_BootClockMarked;
+
+#define DIAG_STACK_PAINT        0x5AA5C33Cu
+
+/**
+ * Paint the unused stack below the caller's frame. Safe with interrupts
+ * enabled: anything an ISR writes below SP is real stack usage.
+ */
+void DIAG_StackPaint(void);
+
+/**
+ * High-water scan, call from the main loop (e.g. once per second).
+ * Scans upwards from _splim to the first overwritten word.
+ */
+void DIAG_StackScan(void);
+
+/**
+ * DIAG_Init(): clear all statistics and paint the stack. Call once at boot.
+ * DIAG_IsrClear(): restart ISR max tracking at runtime.
+ */
+void DIAG_Init(void);
+void DIAG_IsrClear(void);
+
+/**
+ * Latency probe. Pends one probe-able vector per call (round robin) and
+ * waits for the wrapper to consume the reference. Call from the main loop
+ * (IPL0), e.g. once per second.
+ */
+void DIAG_IsrProbe(void);
+
+/**
+ * Handle MBS_DIAG_COMMAND and publish statistics to the input registers.
+ * Call from the main loop at 250 ms cadence.
+ */
+void DIAG_Task_250ms(void);
+
+#endif /* DIAG_H */
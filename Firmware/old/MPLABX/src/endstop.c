@@ -1,16 +1,61 @@
+#include <string.h>
 #include "endstop.h"
 #include "definitions.h"
 #include "ModbusSlave.h"
+#include "inhibit.h"
 
-#ifndef ENDSTOP_DEBOUNCE_MS
-// Hall sensors normally do not need debounce, but we keep a small default to
-// suppress short glitches/noise. Set to 0 to disable.
-#define ENDSTOP_DEBOUNCE_MS  0u
+#ifndef ENDSTOP_GLITCH_US
+// Hall sensors normally do not need debounce. A level must stay this long
+// after its last edge before it is accepted; shorter pulses are dropped.
+// 0 = every edge is accepted in the change notice interrupt. Factory value
+// of the input table, the host can change it per input.
+#define ENDSTOP_GLITCH_US  0u
 #endif
 
-static uint8_t s_raw_last = 0;
-static uint8_t s_stable   = 0;
-static uint8_t s_db_cnt[4] = {0,0,0,0};
+// Pins: VERT_G RD4, VERT_B RD2, FOCUS_G RC13, FOCUS_B RB9
+#define ENDSTOP_CN_B_MASK   (1u << 9)
+#define ENDSTOP_CN_C_MASK   (1u << 13)
+#define ENDSTOP_CN_D_MASK   ((1u << 4) | (1u << 2))
+
+#define ENDSTOP_STATUS_MASK ((uint16_t)(MBS_SL_STATUS_END_STOP_HORIZ_CW |  \
+                                        MBS_SL_STATUS_END_STOP_HORIZ_CCW | \
+                                        MBS_SL_STATUS_END_STOP_VERT_B |   \
+                                        MBS_SL_STATUS_END_STOP_VERT_Y |   \
+                                        MBS_SL_STATUS_END_STOP_FOCUS_B |  \
+                                        MBS_SL_STATUS_END_STOP_FOCUS_Y |  \
+                                        MBS_SL_STATUS_VERT_SENSOR_FAULT | \
+                                        MBS_SL_STATUS_FOCUS_SENSOR_FAULT))
+
+// Shared with the change notice ISR (IPL4); the main loop and the core
+// timer tick only touch them with interrupts disabled.
+static volatile uint8_t  s_raw_last = 0;    // pin levels after the last edge
+static volatile uint8_t  s_stable   = 0;    // accepted levels
+static volatile uint16_t s_status   = 0;    // our bits of MBS_SL_STATUS
+static uint64_t s_edge_t[ENDSTOP_COUNT];    // last raw edge, core timer ticks
+static uint64_t s_stable_t[ENDSTOP_COUNT];  // edge that was accepted
+
+// Chatter statistics since s_stats_t0, same access rules
+static ENDSTOP_Stats_t s_stats[ENDSTOP_COUNT];
+static uint64_t s_stats_t0 = 0;
+
+// Input table; only changed with interrupts disabled
+static ENDSTOP_Config_t s_cfg;
+static uint64_t s_glitch_t[ENDSTOP_COUNT];  // glitchUs in core timer ticks
+static uint8_t  s_active_high = 0;          // polarity, bit per input
+
+// Core timer extended to 64 bit; it wraps every ~358 s and is read at
+// least every few ms (ENDSTOP_Task_1ms), so one wrap check per read does.
+// Boot resets the count (DIAG_BootMark, CORETIMER_Start()) after
+// ENDSTOP_Init(); ENDSTOP_Start() re-bases the clock once it runs.
+static uint32_t s_count_hi = 0;
+static uint32_t s_count_last = 0;
+
+static uint64_t clock_extend(uint32_t now)
+{
+    if (now < s_count_last) s_count_hi++;
+    s_count_last = now;
+    return ((uint64_t)s_count_hi << 32) | now;
+}
 
 static inline uint8_t read_raw_bits(void)
 {
@@ -24,106 +69,305 @@ static inline uint8_t read_raw_bits(void)
     return s;
 }
 
-// CC6201ST: output is normally HIGH, goes LOW when active
-static inline bool is_active_low(bool pin_high)
+// Clear and return the change notice flags, bit per input. A flag is set
+// by every edge, so one without a level change is a pulse too short to
+// be seen on the pin.
+static inline uint8_t take_cn_flags(void)
 {
-    return !pin_high;
+    const uint32_t fb = CNFB & ENDSTOP_CN_B_MASK;
+    const uint32_t fc = CNFC & ENDSTOP_CN_C_MASK;
+    const uint32_t fd = CNFD & ENDSTOP_CN_D_MASK;
+    uint8_t s = 0;
+
+    CNFBCLR = fb;
+    CNFCCLR = fc;
+    CNFDCLR = fd;
+
+    if (fd & (1u << 4))  s |= (1u << ENDSTOP_VERT_G);
+    if (fd & (1u << 2))  s |= (1u << ENDSTOP_VERT_B);
+    if (fc & (1u << 13)) s |= (1u << ENDSTOP_FOCUS_G);
+    if (fb & (1u << 9))  s |= (1u << ENDSTOP_FOCUS_B);
+
+    return s;
 }
 
-static void update_modbus_status(void)
+// Logical state, bit per input
+static inline uint8_t active_bits(uint8_t stable)
 {
-    volatile uint16_t *reg = &MBS_HoldRegisters[MBS_SL_STATUS];
+    return (uint8_t)((stable ^ ~s_active_high) & ((1u << ENDSTOP_COUNT) - 1u));
+}
 
-    const bool vert_g_active  = is_active_low(((s_stable >> ENDSTOP_VERT_G)  & 1u) != 0u);
-    const bool vert_b_active  = is_active_low(((s_stable >> ENDSTOP_VERT_B)  & 1u) != 0u);
-    const bool focus_g_active = is_active_low(((s_stable >> ENDSTOP_FOCUS_G) & 1u) != 0u);
-    const bool focus_b_active = is_active_low(((s_stable >> ENDSTOP_FOCUS_B) & 1u) != 0u);
+static uint16_t status_bits(uint8_t stable)
+{
+    const uint8_t active = active_bits(stable);
+    uint16_t bits = 0u;
 
-    const uint16_t clear_mask =
-        (uint16_t)(MBS_SL_STATUS_END_STOP_VERT_B |
-                   MBS_SL_STATUS_END_STOP_VERT_Y |
-                   MBS_SL_STATUS_END_STOP_FOCUS_B |
-                   MBS_SL_STATUS_END_STOP_FOCUS_Y |
-                   MBS_SL_STATUS_VERT_SENSOR_FAULT |
-                   MBS_SL_STATUS_FOCUS_SENSOR_FAULT);
+    // Endstop bits
+    for (unsigned i = 0; i < ENDSTOP_COUNT; i++)
+    {
+        if (active & (1u << i)) bits |= s_cfg.in[i].status;
+    }
 
-    // Clear relevant bits first (leave other status bits untouched)
-    MBS_RegClearBits(reg, clear_mask);
+    // Fault bits: both inputs of a rule active at once, e.g. both sensors of an axis
+    for (unsigned r = 0; r < ENDSTOP_RULES; r++)
+    {
+        const ENDSTOP_RuleCfg_t *rule = &s_cfg.rule[r];
+        const uint8_t pair = (uint8_t)((1u << rule->a) | (1u << rule->b));
 
-    // Set endstop bits
-    if (vert_b_active)  MBS_RegSetBits(reg, MBS_SL_STATUS_END_STOP_VERT_B);
-    if (vert_g_active)  MBS_RegSetBits(reg, MBS_SL_STATUS_END_STOP_VERT_Y);
-    if (focus_b_active) MBS_RegSetBits(reg, MBS_SL_STATUS_END_STOP_FOCUS_B);
-    if (focus_g_active) MBS_RegSetBits(reg, MBS_SL_STATUS_END_STOP_FOCUS_Y);
+        if ((active & pair) == pair) bits |= rule->status;
+    }
 
-    // Fault bits: both sensors active simultaneously on same axis
-    if (vert_b_active && vert_g_active)    MBS_RegSetBits(reg, MBS_SL_STATUS_VERT_SENSOR_FAULT);
-    if (focus_b_active && focus_g_active)  MBS_RegSetBits(reg, MBS_SL_STATUS_FOCUS_SENSOR_FAULT);
+    return bits;
 }
 
-void ENDSTOP_Init(void)
+// Interrupts disabled or change notice ISR
+static void update_modbus_status(void)
 {
-    s_raw_last = read_raw_bits();
-    s_stable   = s_raw_last;
-
-    for (unsigned i = 0; i < 4u; i++)
-        s_db_cnt[i] = 0u;
+    volatile uint16_t *reg = &MBS_HoldRegisters[MBS_SL_STATUS];
 
-    // Initial sync (important for missing board case)
-    update_modbus_status();
+    // Clear relevant bits first (leave other status bits untouched)
+    MBS_RegClearBits(reg, ENDSTOP_STATUS_MASK);
+    MBS_RegSetBits(reg, s_status);
 }
 
-void ENDSTOP_Task_1ms(void)
+/*
+ * Take the pin levels at 'now': record new edges, accept levels that have
+ * been steady for the glitch time of the input and publish the status bits.
+ * Interrupts disabled or change notice ISR.
+ */
+static void process(uint64_t now)
 {
+    // Flags before the pins: an edge after this read sets them again
+    const uint8_t flagged = take_cn_flags();
     const uint8_t raw_now = read_raw_bits();
-    bool changed_any = false;
+    const uint8_t edges = (uint8_t)(raw_now ^ s_raw_last);
+    uint8_t stable = s_stable;
 
-    for (endstop_id_t id = ENDSTOP_VERT_G; id <= ENDSTOP_FOCUS_B; id++)
+    for (endstop_id_t id = ENDSTOP_VERT_G; id < ENDSTOP_COUNT; id++)
     {
         const uint8_t mask = (uint8_t)(1u << (uint8_t)id);
-        const bool raw_bit_now  = (raw_now & mask) != 0u;
-        const bool raw_bit_last = (s_raw_last & mask) != 0u;
-        const bool stable_bit   = (s_stable & mask) != 0u;
+        ENDSTOP_Stats_t *st = &s_stats[id];
 
-        if (raw_bit_now != raw_bit_last)
+        if (edges & mask)
         {
-            // Input changed since last sample -> restart debounce timer
-            if (raw_bit_now) s_raw_last |= mask;
-            else             s_raw_last &= (uint8_t)~mask;
+            const uint64_t pulse = now - s_edge_t[id];
 
-            s_db_cnt[(uint8_t)id] = 0u;
-            continue;
-        }
+            st->rawEdges++;
+            if (pulse < st->minPulse) st->minPulse = (pulse > UINT32_MAX) ? UINT32_MAX : (uint32_t)pulse;
+            s_edge_t[id] = now;
 
-#if (ENDSTOP_DEBOUNCE_MS == 0u)
-        if (raw_bit_now != stable_bit)
-        {
-            if (raw_bit_now) s_stable |= mask;
-            else             s_stable &= (uint8_t)~mask;
-
-            changed_any = true;
+            // Back at the accepted level before the filter let it through
+            if (((raw_now ^ stable) & mask) == 0u) st->glitches++;
         }
-#else
-        if (s_db_cnt[(uint8_t)id] < ENDSTOP_DEBOUNCE_MS)
+        else if (flagged & mask)
         {
-            s_db_cnt[(uint8_t)id]++;
-            continue;
+            // Out and back between two reads of the pin
+            st->rawEdges += 2u;
+            st->glitches++;
+            st->minPulse = 0;
         }
 
-        if (raw_bit_now != stable_bit)
+        // A pulse shorter than the filter returns to 'stable' and is dropped here
+        if (((raw_now ^ stable) & mask) != 0u &&
+            (now - s_edge_t[id]) >= s_glitch_t[id])
         {
-            if (raw_bit_now) s_stable |= mask;
-            else             s_stable &= (uint8_t)~mask;
+            stable ^= mask;
+            s_stable_t[id] = s_edge_t[id];
+            st->edges++;
+            ENDSTOP_OnEdge(id, (active_bits(stable) & mask) != 0u, s_edge_t[id]);
+        }
+    }
+    s_raw_last = raw_now;
 
-            changed_any = true;
+    if (stable != s_stable)
+    {
+        s_stable = stable;
+        // X5 FA first: it stops the driver
+        INHIBIT_OnEndstops(active_bits(stable));
+        s_status = status_bits(stable);
+        update_modbus_status();
+    }
+}
+
+static void cn_enable(void)
+{
+    // Edge detect on both edges, per pin flags in CNFx
+    CNCONBSET = _CNCONB_ON_MASK | _CNCONB_CNSTYLE_MASK;
+    CNCONCSET = _CNCONC_ON_MASK | _CNCONC_CNSTYLE_MASK;
+    CNCONDSET = _CNCOND_ON_MASK | _CNCOND_CNSTYLE_MASK;
+    CNEN0BSET = ENDSTOP_CN_B_MASK;  CNEN1BSET = ENDSTOP_CN_B_MASK;
+    CNEN0CSET = ENDSTOP_CN_C_MASK;  CNEN1CSET = ENDSTOP_CN_C_MASK;
+    CNEN0DSET = ENDSTOP_CN_D_MASK;  CNEN1DSET = ENDSTOP_CN_D_MASK;
+    CNFBCLR = ENDSTOP_CN_B_MASK;
+    CNFCCLR = ENDSTOP_CN_C_MASK;
+    CNFDCLR = ENDSTOP_CN_D_MASK;
+
+    EVIC_SourceStatusClear(INT_SOURCE_CHANGE_NOTICE_B);
+    EVIC_SourceStatusClear(INT_SOURCE_CHANGE_NOTICE_C);
+    EVIC_SourceStatusClear(INT_SOURCE_CHANGE_NOTICE_D);
+    EVIC_SourceEnable(INT_SOURCE_CHANGE_NOTICE_B);
+    EVIC_SourceEnable(INT_SOURCE_CHANGE_NOTICE_C);
+    EVIC_SourceEnable(INT_SOURCE_CHANGE_NOTICE_D);
+}
+
+// Interrupts disabled
+static void apply_config(const ENDSTOP_Config_t *cfg)
+{
+    s_cfg = *cfg;
+    s_active_high = 0;
+
+    for (unsigned i = 0; i < ENDSTOP_COUNT; i++)
+    {
+        s_cfg.in[i].activeHigh = (cfg->in[i].activeHigh != 0u) ? 1u : 0u;
+        s_cfg.in[i].status &= ENDSTOP_STATUS_MASK;
+        s_glitch_t[i] = (uint64_t)s_cfg.in[i].glitchUs * ENDSTOP_TICKS_PER_US;
+        if (s_cfg.in[i].activeHigh) s_active_high |= (uint8_t)(1u << i);
+    }
+
+    for (unsigned r = 0; r < ENDSTOP_RULES; r++)
+    {
+        ENDSTOP_RuleCfg_t *rule = &s_cfg.rule[r];
+
+        rule->status &= ENDSTOP_STATUS_MASK;
+        if (rule->a >= ENDSTOP_COUNT || rule->b >= ENDSTOP_COUNT || rule->status == 0u)
+        {
+            rule->a = 0;
+            rule->b = 0;
+            rule->status = 0;
         }
-#endif
     }
+}
 
-    if (changed_any)
+void ENDSTOP_GetDefaultConfig(ENDSTOP_Config_t *cfg)
+{
+    static const uint16_t status[ENDSTOP_COUNT] = {
+        [ENDSTOP_VERT_G]  = MBS_SL_STATUS_END_STOP_VERT_Y,
+        [ENDSTOP_VERT_B]  = MBS_SL_STATUS_END_STOP_VERT_B,
+        [ENDSTOP_FOCUS_G] = MBS_SL_STATUS_END_STOP_FOCUS_Y,
+        [ENDSTOP_FOCUS_B] = MBS_SL_STATUS_END_STOP_FOCUS_B,
+    };
+
+    memset(cfg, 0, sizeof(*cfg));
+
+    // CC6201ST: output is normally HIGH, goes LOW when active
+    for (unsigned i = 0; i < ENDSTOP_COUNT; i++)
+    {
+        cfg->in[i].activeHigh = 0;
+        cfg->in[i].glitchUs = ENDSTOP_GLITCH_US;
+        cfg->in[i].status = status[i];
+    }
+
+    // Both sensors of an axis active: missing sensor board (pull-downs) or wiring
+    cfg->rule[0] = (ENDSTOP_RuleCfg_t){ ENDSTOP_VERT_B, ENDSTOP_VERT_G, MBS_SL_STATUS_VERT_SENSOR_FAULT };
+    cfg->rule[1] = (ENDSTOP_RuleCfg_t){ ENDSTOP_FOCUS_B, ENDSTOP_FOCUS_G, MBS_SL_STATUS_FOCUS_SENSOR_FAULT };
+}
+
+void ENDSTOP_SetConfig(const ENDSTOP_Config_t *cfg)
+{
+    const bool irq = EVIC_INT_Disable();
+
+    apply_config(cfg);
+
+    // New polarity / mapping takes effect now; a longer glitch time only
+    // applies to the next edge
+    INHIBIT_OnEndstops(active_bits(s_stable));
+    s_status = status_bits(s_stable);
+    update_modbus_status();
+
+    EVIC_INT_Restore(irq);
+}
+
+void ENDSTOP_GetConfig(ENDSTOP_Config_t *cfg)
+{
+    const bool irq = EVIC_INT_Disable();
+
+    *cfg = s_cfg;
+    EVIC_INT_Restore(irq);
+}
+
+void ENDSTOP_Init(void)
+{
+    const uint64_t now = clock_extend(_CP0_GET_COUNT());
+    ENDSTOP_Config_t cfg;
+
+    ENDSTOP_GetDefaultConfig(&cfg);
+    apply_config(&cfg);
+
+    s_raw_last = read_raw_bits();
+    s_stable   = s_raw_last;
+    s_status   = status_bits(s_stable);
+    ENDSTOP_ClearStats();
+
+    for (unsigned i = 0; i < ENDSTOP_COUNT; i++)
+    {
+        s_edge_t[i] = now;
+        s_stable_t[i] = now;
+    }
+
+    // Initial sync (important for missing board case)
+    update_modbus_status();
+
+    cn_enable();
+}
+
+void ENDSTOP_Start(void)
+{
+    const bool irq = EVIC_INT_Disable();
+    const uint32_t now = _CP0_GET_COUNT();
+
+    // A read before the count was reset must not count as a wrap
+    s_count_hi = 0;
+    s_count_last = now;
+
+    for (unsigned i = 0; i < ENDSTOP_COUNT; i++)
+    {
+        s_edge_t[i] = now;
+        s_stable_t[i] = now;
+    }
+    s_stats_t0 = now;
+
+    EVIC_INT_Restore(irq);
+}
+
+void ENDSTOP_CN_InterruptHandler(void)
+{
+    const uint32_t now = _CP0_GET_COUNT();
+
+    // Interrupt flags first: an edge after this point raises it again;
+    // process() takes the per pin flags
+    EVIC_SourceStatusClear(INT_SOURCE_CHANGE_NOTICE_B);
+    EVIC_SourceStatusClear(INT_SOURCE_CHANGE_NOTICE_C);
+    EVIC_SourceStatusClear(INT_SOURCE_CHANGE_NOTICE_D);
+
+    process(clock_extend(now));
+}
+
+void ENDSTOP_Tick_1ms(void)
+{
+    // Only while a level is held back by the glitch filter
+    if (s_raw_last != s_stable)
+    {
+        const bool irq = EVIC_INT_Disable();
+        process(clock_extend(_CP0_GET_COUNT()));
+        EVIC_INT_Restore(irq);
+    }
+}
+
+void ENDSTOP_Task_1ms(void)
+{
+    const bool irq = EVIC_INT_Disable();
+
+    // Keeps the 64-bit clock going, and catches an edge the CN logic missed
+    process(clock_extend(_CP0_GET_COUNT()));
+
+    // Main loop writes to MBS_SL_STATUS (timeout clear, TLV bits) can race
+    // the ISR; put our bits back if they were lost
+    if ((MBS_HoldRegisters[MBS_SL_STATUS] & ENDSTOP_STATUS_MASK) != s_status)
     {
         update_modbus_status();
     }
+
+    EVIC_INT_Restore(irq);
 }
 
 bool ENDSTOP_GetRaw(endstop_id_t id)
@@ -133,5 +377,83 @@ bool ENDSTOP_GetRaw(endstop_id_t id)
 
 bool ENDSTOP_IsActive(endstop_id_t id)
 {
-    return !ENDSTOP_GetRaw(id);
+    return ((active_bits(s_stable) >> (uint8_t)id) & 1u) != 0u;
+}
+
+void __attribute__((weak)) ENDSTOP_OnEdge(endstop_id_t id, bool active, uint64_t t)
+{
+    (void)id; (void)active; (void)t;
+}
+
+uint32_t ENDSTOP_GetEdgeUs(endstop_id_t id)
+{
+    const bool irq = EVIC_INT_Disable();
+    const uint64_t t = s_stable_t[(uint8_t)id % ENDSTOP_COUNT];
+
+    EVIC_INT_Restore(irq);
+    return (uint32_t)(t / ENDSTOP_TICKS_PER_US);
+}
+
+uint32_t ENDSTOP_NowUs(void)
+{
+    const bool irq = EVIC_INT_Disable();
+    const uint64_t t = clock_extend(_CP0_GET_COUNT());
+
+    EVIC_INT_Restore(irq);
+    return (uint32_t)(t / ENDSTOP_TICKS_PER_US);
+}
+
+void ENDSTOP_GetStats(endstop_id_t id, ENDSTOP_Stats_t *st)
+{
+    const bool irq = EVIC_INT_Disable();
+
+    *st = s_stats[(uint8_t)id % ENDSTOP_COUNT];
+    EVIC_INT_Restore(irq);
+}
+
+void ENDSTOP_ClearStats(void)
+{
+    const bool irq = EVIC_INT_Disable();
+
+    memset(s_stats, 0, sizeof(s_stats));
+    for (unsigned i = 0; i < ENDSTOP_COUNT; i++) s_stats[i].minPulse = UINT32_MAX;
+    s_stats_t0 = clock_extend(_CP0_GET_COUNT());
+
+    EVIC_INT_Restore(irq);
+}
+
+static uint16_t sat16(uint32_t v)
+{
+    return (uint16_t)((v > 0xFFFFu) ? 0xFFFFu : v);
+}
+
+void ENDSTOP_Task_250ms(void)
+{
+    ENDSTOP_Stats_t st[ENDSTOP_COUNT];
+    uint32_t window_s;
+    bool irq;
+
+    if (MBS_RegIsBitsSet(MBS_HoldRegisters[MBS_DIAG_COMMAND], MBS_DIAG_CMD_CLEAR_ENDSTOP_STATS)) {
+        ENDSTOP_ClearStats();
+        MBS_RegClearBits(&MBS_HoldRegisters[MBS_DIAG_COMMAND], MBS_DIAG_CMD_CLEAR_ENDSTOP_STATS);
+    }
+
+    // One consistent set, all inputs from the same moment
+    irq = EVIC_INT_Disable();
+    memcpy(st, s_stats, sizeof(st));
+    window_s = (uint32_t)((clock_extend(_CP0_GET_COUNT()) - s_stats_t0) / CORE_TIMER_FREQUENCY);
+    EVIC_INT_Restore(irq);
+
+    MBS_InputRegisters[MBS_IR_ESTAT_WINDOW_S_HI] = (uint16_t)(window_s >> 16);
+    MBS_InputRegisters[MBS_IR_ESTAT_WINDOW_S_LO] = (uint16_t)window_s;
+
+    for (unsigned i = 0; i < ENDSTOP_COUNT; i++)
+    {
+        volatile uint16_t *r = &MBS_InputRegisters[MBS_IR_ESTAT_ENTRY + i * MBS_IR_ESTAT_STRIDE];
+
+        r[MBS_IR_ESTAT_RAW_EDGES] = (uint16_t)st[i].rawEdges;
+        r[MBS_IR_ESTAT_EDGES]     = (uint16_t)st[i].edges;
+        r[MBS_IR_ESTAT_GLITCHES]  = (uint16_t)st[i].glitches;
+        r[MBS_IR_ESTAT_MIN_PULSE_US] = sat16(st[i].minPulse / ENDSTOP_TICKS_PER_US);
+    }
 }
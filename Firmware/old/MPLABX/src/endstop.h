@@ -11,24 +11,114 @@ typedef enum {
     ENDSTOP_FOCUS_B
 } endstop_id_t;
 
+#define ENDSTOP_COUNT           4u
+#define ENDSTOP_RULES           4u
+
+/* One input: polarity, glitch filter and the MBS_SL_STATUS bits it drives */
+typedef struct {
+    uint8_t  activeHigh;        /* 0 = active low (CC6201ST) */
+    uint16_t glitchUs;          /* level must be steady this long, 0 = every edge */
+    uint16_t status;            /* MBS_SL_STATUS bits set while active */
+} ENDSTOP_InputCfg_t;
+
+/* Pairwise fault rule: both inputs active at once sets 'status' */
+typedef struct {
+    uint8_t  a, b;              /* endstop_id_t */
+    uint16_t status;            /* 0 = rule off */
+} ENDSTOP_RuleCfg_t;
+
+typedef struct {
+    ENDSTOP_InputCfg_t in[ENDSTOP_COUNT];
+    ENDSTOP_RuleCfg_t  rule[ENDSTOP_RULES];
+} ENDSTOP_Config_t;
+
+/* Chatter statistics of one input since ENDSTOP_ClearStats() */
+typedef struct {
+    uint32_t rawEdges;          /* pin transitions, including dropped pulses */
+    uint32_t edges;             /* levels accepted by the glitch filter */
+    uint32_t glitches;          /* pulses dropped: shorter than glitchUs or than a pin read */
+    uint32_t minPulse;          /* shortest time between two raw edges, core timer ticks; UINT32_MAX = none */
+} ENDSTOP_Stats_t;
+
 /**
  * Initialize endstop driver.
- * - Samples current pin levels and initializes debounce state.
+ * - Samples current pin levels and initializes the glitch filter state.
  * - Updates MBS_HoldRegisters[MBS_SL_STATUS] immediately (incl. fault bits),
  *   which is important to detect missing sensor-board at boot (both low).
+ * - Enables the change notice interrupts (ports B, C, D, both edges).
  */
 void ENDSTOP_Init(void);
 
 /**
- * Call from main loop at a fixed 1ms cadence to debounce inputs, detect changes
- * and keep Modbus status bits updated.
+ * Re-base the timestamp clock on the running core timer: edge times, the
+ * statistics window and the wrap count start from the current count.
+ * Call right after CORETIMER_Start(), which resets the count.
+ */
+void ENDSTOP_Start(void);
+
+/**
+ * Change notice ISR (IPL4, shared by ports B/C/D). Timestamps the edge from
+ * the core timer and updates MBS_SL_STATUS within a few microseconds.
+ */
+void ENDSTOP_CN_InterruptHandler(void);
+
+/**
+ * Call from the 1 ms core timer interrupt. Accepts levels the glitch filter
+ * (ENDSTOP_InputCfg_t.glitchUs) held back; nothing to do when it is 0.
+ */
+void ENDSTOP_Tick_1ms(void);
+
+/**
+ * Call from main loop at a fixed 1ms cadence. Keeps the timestamp clock
+ * running, catches missed edges and restores the Modbus status bits if a
+ * main loop write to MBS_SL_STATUS dropped them.
  */
 void ENDSTOP_Task_1ms(void);
 
-/** Returns debounced raw GPIO level (true = pin high). */
+/** Returns filtered raw GPIO level (true = pin high). */
 bool ENDSTOP_GetRaw(endstop_id_t id);
 
-/** Returns logical active state (true = endstop active). Active-low handled internally. */
+/** Returns logical active state (true = endstop active), polarity from the input table. */
 bool ENDSTOP_IsActive(endstop_id_t id);
 
+/** Time of the edge that produced the current level, us since boot (wraps after ~71 min). */
+uint32_t ENDSTOP_GetEdgeUs(endstop_id_t id);
+
+/** Current time on the same clock as ENDSTOP_GetEdgeUs(). */
+uint32_t ENDSTOP_NowUs(void);
+
+/** Copy the statistics of one input. */
+void ENDSTOP_GetStats(endstop_id_t id, ENDSTOP_Stats_t *st);
+
+/** Zero the statistics of all inputs and start a new window. */
+void ENDSTOP_ClearStats(void);
+
+/**
+ * Call from main loop at 250 ms. Handles MBS_DIAG_CMD_CLEAR_ENDSTOP_STATS
+ * and publishes the statistics (MBS_IR_ESTAT_xxx).
+ */
+void ENDSTOP_Task_250ms(void);
+
+#define ENDSTOP_TICKS_PER_US    (CORE_TIMER_FREQUENCY / 1000000u)
+
+/** Factory input table: active low, ENDSTOP_GLITCH_US, the MBS_SL_STATUS endstop / fault bits. */
+void ENDSTOP_GetDefaultConfig(ENDSTOP_Config_t *cfg);
+
+/**
+ * Replace the input table and re-evaluate the status bits. Status masks
+ * are limited to the endstop bits of MBS_SL_STATUS, a rule with an
+ * unknown input is switched off. Main loop.
+ */
+void ENDSTOP_SetConfig(const ENDSTOP_Config_t *cfg);
+
+/** Table in use, after the limits of ENDSTOP_SetConfig(). */
+void ENDSTOP_GetConfig(ENDSTOP_Config_t *cfg);
+
+/**
+ * Hook for every accepted edge, weak default does nothing. Runs in the
+ * change notice ISR (IPL4) or with interrupts disabled, keep it short.
+ * t = core timer ticks since boot, 64 bit (ENDSTOP_TICKS_PER_US).
+ */
+void ENDSTOP_OnEdge(endstop_id_t id, bool active, uint64_t t);
+
 #endif
@@ -0,0 +1,150 @@
+#include <string.h>
+#include "definitions.h"
+#include "ModbusSlave.h"
+#include "nvstore.h"
+#include "inhibit.h"
+#include "endstop_cfg.h"
+
+#define CFG_CMD_ALL     (MBS_INCFG_CMD_SAVE | MBS_INCFG_CMD_RELOAD | MBS_INCFG_CMD_DEFAULTS)
+
+static ENDSTOP_Config_t cfgUsed;            /* as published in the holding registers */
+static uint16_t rulesUsed[INHIBIT_RULES];   /* X5 FA inhibit rules, same */
+static uint16_t cfgState = 0u;              /* MBS_INCFG_STATE_xxx */
+
+static void CFG_Publish(const ENDSTOP_Config_t *c)
+{
+    for (uint8_t i = 0u; i < ENDSTOP_COUNT; i++) {
+        volatile uint16_t *r = &MBS_HoldRegisters[MBS_INCFG_IN_BASE + i * MBS_INCFG_IN_STRIDE];
+
+        r[MBS_INCFG_IN_POLARITY]  = c->in[i].activeHigh;
+        r[MBS_INCFG_IN_GLITCH_US] = c->in[i].glitchUs;
+        r[MBS_INCFG_IN_STATUS]    = c->in[i].status;
+    }
+    for (uint8_t i = 0u; i < ENDSTOP_RULES; i++) {
+        volatile uint16_t *r = &MBS_HoldRegisters[MBS_INCFG_RULE_BASE + i * MBS_INCFG_RULE_STRIDE];
+
+        r[MBS_INCFG_RULE_A]      = c->rule[i].a;
+        r[MBS_INCFG_RULE_B]      = c->rule[i].b;
+        r[MBS_INCFG_RULE_STATUS] = c->rule[i].status;
+    }
+}
+
+static uint8_t CFG_RegU8(uint16_t v)
+{
+    return (uint8_t)((v > 255u) ? 255u : v);
+}
+
+static void CFG_FromRegs(ENDSTOP_Config_t *c)
+{
+    memset(c, 0, sizeof(*c));
+
+    for (uint8_t i = 0u; i < ENDSTOP_COUNT; i++) {
+        volatile uint16_t *r = &MBS_HoldRegisters[MBS_INCFG_IN_BASE + i * MBS_INCFG_IN_STRIDE];
+
+        c->in[i].activeHigh = CFG_RegU8(r[MBS_INCFG_IN_POLARITY]);
+        c->in[i].glitchUs   = r[MBS_INCFG_IN_GLITCH_US];
+        c->in[i].status     = r[MBS_INCFG_IN_STATUS];
+    }
+    for (uint8_t i = 0u; i < ENDSTOP_RULES; i++) {
+        volatile uint16_t *r = &MBS_HoldRegisters[MBS_INCFG_RULE_BASE + i * MBS_INCFG_RULE_STRIDE];
+
+        c->rule[i].a      = CFG_RegU8(r[MBS_INCFG_RULE_A]);
+        c->rule[i].b      = CFG_RegU8(r[MBS_INCFG_RULE_B]);
+        c->rule[i].status = r[MBS_INCFG_RULE_STATUS];
+    }
+}
+
+static void CFG_RulesFromRegs(uint16_t rule[INHIBIT_RULES])
+{
+    for (uint8_t r = 0u; r < INHIBIT_RULES; r++) rule[r] = MBS_HoldRegisters[MBS_INHIBIT_RULE_BASE + r];
+}
+
+/* Same for the inhibit rules */
+static bool CFG_ApplyRules(const uint16_t rule[INHIBIT_RULES])
+{
+    INHIBIT_SetRules(rule);
+    INHIBIT_GetRules(rulesUsed);
+    for (uint8_t r = 0u; r < INHIBIT_RULES; r++) MBS_HoldRegisters[MBS_INHIBIT_RULE_BASE + r] = rulesUsed[r];
+
+    return memcmp(rule, rulesUsed, sizeof(rulesUsed)) == 0;
+}
+
+/* Hand the table to the driver, publish what it made of it. True if taken as is. */
+static bool CFG_Apply(const ENDSTOP_Config_t *c)
+{
+    ENDSTOP_SetConfig(c);
+    memset(&cfgUsed, 0, sizeof(cfgUsed));
+    ENDSTOP_GetConfig(&cfgUsed);
+    CFG_Publish(&cfgUsed);
+
+    return memcmp(c, &cfgUsed, sizeof(cfgUsed)) == 0;
+}
+
+/* Stored table, or the factory one if there is none */
+static void CFG_Load(void)
+{
+    ENDSTOP_Config_t c;
+    uint16_t rule[INHIBIT_RULES];
+
+    memset(&c, 0, sizeof(c));
+    if (NVS_Read(NVS_ID_INPUTS, &c, (uint16_t)sizeof(c))) {
+        cfgState = MBS_INCFG_STATE_STORED;
+    } else {
+        ENDSTOP_GetDefaultConfig(&c);
+        cfgState = 0u;
+    }
+    (void)CFG_Apply(&c);
+
+    /* Not in images written before the rules existed */
+    if (!NVS_Read(NVS_ID_INHIBIT, rule, (uint16_t)sizeof(rule))) INHIBIT_GetDefaultRules(rule);
+    (void)CFG_ApplyRules(rule);
+}
+
+void ENDSTOP_CfgInit(void)
+{
+    CFG_Load();
+    MBS_InputRegisters[MBS_IR_INCFG_STATE] = cfgState;
+}
+
+void ENDSTOP_CfgTask_250ms(void)
+{
+    uint16_t cmd = MBS_HoldRegisters[MBS_INCFG_CMD] & CFG_CMD_ALL;
+    ENDSTOP_Config_t c;
+    uint16_t rule[INHIBIT_RULES];
+
+    /* Register edits first, so a table and SAVE can come in one write */
+    CFG_FromRegs(&c);
+    if (memcmp(&c, &cfgUsed, sizeof(c)) != 0) {
+        cfgState &= (uint16_t)~(MBS_INCFG_STATE_STORED | MBS_INCFG_STATE_REFUSED);
+        if (!CFG_Apply(&c)) cfgState |= MBS_INCFG_STATE_REFUSED;
+    }
+    CFG_RulesFromRegs(rule);
+    if (memcmp(rule, rulesUsed, sizeof(rule)) != 0) {
+        cfgState &= (uint16_t)~(MBS_INCFG_STATE_STORED | MBS_INCFG_STATE_REFUSED);
+        if (!CFG_ApplyRules(rule)) cfgState |= MBS_INCFG_STATE_REFUSED;
+    }
+
+    if (MBS_RegIsBitsSet(cmd, MBS_INCFG_CMD_DEFAULTS)) {
+        ENDSTOP_GetDefaultConfig(&c);
+        (void)CFG_Apply(&c);
+        INHIBIT_GetDefaultRules(rule);
+        (void)CFG_ApplyRules(rule);
+        cfgState = 0u;
+    } else if (MBS_RegIsBitsSet(cmd, MBS_INCFG_CMD_RELOAD)) {
+        CFG_Load();
+    }
+
+    if (MBS_RegIsBitsSet(cmd, MBS_INCFG_CMD_SAVE)) {
+        /* Both records in one page write */
+        if (NVS_Stage(NVS_ID_INPUTS, &cfgUsed, (uint16_t)sizeof(cfgUsed)) &&
+            NVS_Stage(NVS_ID_INHIBIT, rulesUsed, (uint16_t)sizeof(rulesUsed)) &&
+            NVS_Commit()) {
+            cfgState = (uint16_t)((cfgState | MBS_INCFG_STATE_STORED) & ~MBS_INCFG_STATE_SAVE_FAILED);
+        } else {
+            cfgState |= MBS_INCFG_STATE_SAVE_FAILED;
+        }
+    }
+
+    if (cmd != 0u) MBS_RegClearBits(&MBS_HoldRegisters[MBS_INCFG_CMD], cmd);
+    MBS_InputRegisters[MBS_IR_INCFG_STATE] = cfgState;
+}
@@ -0,0 +1,27 @@
+#ifndef ENDSTOP_CFG_H
+#define ENDSTOP_CFG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "endstop.h"
+
+/* =========================================================================
+ * Endstop input table from the host
+ *
+ * Polarity, glitch time and MBS_SL_STATUS mapping per input plus the
+ * pairwise fault rules (ENDSTOP_Config_t) are mirrored in holding
+ * registers MBS_INCFG_xxx. Changes are handed to ENDSTOP_SetConfig()
+ * every 250 ms; the values it refuses are written back as the ones in
+ * use. The X5 FA inhibit rules (MBS_INHIBIT_RULE_BASE, INHIBIT_SetRules())
+ * are handled the same way. MBS_INCFG_CMD_SAVE stores both in one flash
+ * page write (NVS_Stage() + NVS_Commit()), and at boot the stored tables
+ * replace the factory ones.
+ * ========================================================================= */
+
+/** Load the stored tables and publish them. Call after NVS_Init(), ENDSTOP_Init(), INHIBIT_Init() and MBS_InitModbus(). */
+void ENDSTOP_CfgInit(void);
+
+/** Apply register changes, handle MBS_INCFG_CMD. Call at 250 ms cadence. */
+void ENDSTOP_CfgTask_250ms(void);
+
+#endif /* ENDSTOP_CFG_H */
@@ -0,0 +1,77 @@
+#include "definitions.h"
+#include "ModbusSlave.h"
+#include "tlv493d.h"
+#include "seqring.h"
+#include "endstop_log.h"
+
+#define LOG_NONE    ((uint16_t)0x8000u)
+
+/* ===================== Log ===================== */
+typedef struct {
+    uint64_t t;             /* core timer ticks since boot */
+    uint16_t event;         /* MBS_IR_ESLOG_EVENT layout */
+    uint16_t heading;
+    uint16_t cmdPos;
+} LOG_ENTRY;
+
+_Static_assert(MBS_IR_ESLOG_ENTRY == MBS_IR_ESLOG_BASE + SEQRING_IR_ENTRY, "ESLOG header is the seqring one");
+
+/* Producer: change notice ISR or interrupts disabled. Consumer: main loop. */
+static LOG_ENTRY logBuf[ENDSTOP_LOG_LEN];
+static uint16_t logSeq[ENDSTOP_LOG_LEN];
+static SEQRING_DEFINE(logRing, logSeq);
+
+void ENDSTOP_LogInit(void)
+{
+    bool irq = EVIC_INT_Disable();
+
+    SEQRING_Reset(&logRing);
+    EVIC_INT_Restore(irq);
+}
+
+/* Axis state as published to Modbus; 16-bit reads, safe from the ISR */
+static void LOG_Axis(endstop_id_t id, uint16_t *heading, uint16_t *cmdPos)
+{
+    const bool vert = (id == ENDSTOP_VERT_G || id == ENDSTOP_VERT_B);
+    const uint8_t tlv = vert ? (uint8_t)TLV493D_VERT : (uint8_t)TLV493D_FOCUS;
+    const volatile uint16_t *r = &MBS_InputRegisters[MBS_IR_TLVS_BASE + tlv * MBS_IR_TLVS_STRIDE];
+
+    *heading = (r[MBS_IR_TLVS_AGE] == 0xFFFFu) ? LOG_NONE : r[MBS_IR_TLVS_HEADING];
+
+    /* The focus axis has no position command */
+    *cmdPos = vert ? MBS_HoldRegisters[MBS_SET_VERT_POS_RAW] : LOG_NONE;
+}
+
+void ENDSTOP_OnEdge(endstop_id_t id, bool active, uint64_t t)
+{
+    uint16_t slot;
+
+    if (!SEQRING_Claim(&logRing, &slot)) return;
+
+    LOG_ENTRY *e = &logBuf[slot];
+
+    e->t = t;
+    e->event = (uint16_t)(((uint16_t)id & 0x03u) | (active ? MBS_IR_ESLOG_EVENT_ACTIVE : 0u));
+    LOG_Axis(id, &e->heading, &e->cmdPos);
+    SEQRING_Push(&logRing);
+}
+
+static void LOG_Put(uint16_t slot, volatile uint16_t *r)
+{
+    const LOG_ENTRY *e = &logBuf[slot];
+    const uint32_t us = (uint32_t)(e->t / ENDSTOP_TICKS_PER_US);
+
+    r[MBS_IR_ESLOG_T_US_HI]  = (uint16_t)(us >> 16);
+    r[MBS_IR_ESLOG_T_US_LO]  = (uint16_t)us;
+    r[MBS_IR_ESLOG_EVENT]    = e->event;
+    r[MBS_IR_ESLOG_HEADING]  = e->heading;
+    r[MBS_IR_ESLOG_CMD_POS]  = e->cmdPos;
+}
+
+void ENDSTOP_LogOnRead(uint16_t start, uint16_t count)
+{
+    if (start != MBS_IR_ESLOG_BASE) return;
+
+    SEQRING_Read(&logRing, &MBS_InputRegisters[MBS_IR_ESLOG_BASE], count,
+                 MBS_IR_ESLOG_ENTRIES, MBS_IR_ESLOG_STRIDE, LOG_Put);
+}
@@ -0,0 +1,29 @@
+#ifndef ENDSTOP_LOG_H
+#define ENDSTOP_LOG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "endstop.h"
+
+/* =========================================================================
+ * Endstop event log for the host
+ *
+ * Every accepted endstop edge (ENDSTOP_OnEdge() hook, change notice ISR)
+ * is queued with its timestamp, the direction, and what the axis was
+ * doing at that moment: the last published heading of the axis TLV493D
+ * and the commanded position from the holding registers. A Modbus
+ * function 4 read starting at MBS_IR_ESLOG_BASE pops up to
+ * MBS_IR_ESLOG_ENTRIES events, so the whole log comes in one request.
+ *
+ * Same ring as the TLV493D sample FIFO (seqring.h): the read is destructive,
+ * every event gets a 16-bit sequence number (dropped ones too) and one
+ * read only returns consecutive events.
+ * ========================================================================= */
+#define ENDSTOP_LOG_LEN             32u     /* power of two */
+
+void ENDSTOP_LogInit(void);
+
+/** Call from MBS_OnReadInputRegisters(). Main loop context. */
+void ENDSTOP_LogOnRead(uint16_t start, uint16_t count);
+
+#endif /* ENDSTOP_LOG_H */
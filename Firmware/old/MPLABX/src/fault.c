@@ -0,0 +1,195 @@
+#include "definitions.h"
+#include "ModbusSlave.h"
+#include "supervisor.h"
+#include "fault.h"
+
+/* ===================== Constants ===================== */
+#define FAULT_PERSIST_MAGIC     0x464C5433u     /* "FLT3", layout with beats and supply drop */
+
+extern volatile uint32_t myTime;                /* main.c, 1 ms tick */
+
+/* ===================== Trace ring ===================== */
+typedef struct {
+    uint32_t ms;
+    uint16_t arg;
+    uint8_t  ev;
+    uint8_t  rsv;
+} FAULT_TRACE_ENTRY;
+
+static FAULT_TRACE_ENTRY faultRing[FAULT_TRACE_LEN];
+static uint8_t faultHead = 0u;                  /* next write position */
+static uint8_t faultN = 0u;
+
+typedef struct {
+    uint32_t ms;                                /* last one */
+    uint32_t count;
+    uint16_t arg;
+    uint16_t rsv;
+} FAULT_BEAT_ENTRY;
+
+static FAULT_BEAT_ENTRY faultBeat[FAULT_BEAT_COUNT];
+
+typedef struct {
+    uint32_t count;                             /* drops since POR */
+    uint32_t ms;                                /* uptime at the last one, in its run */
+    uint16_t minMv;                             /* lowest supply of the last one */
+    uint16_t resets;                            /* resets since the last one, 0 = this run */
+} FAULT_DROP_ENTRY;
+
+/* ===================== Persistent record (survives reset, not POR) ===================== */
+typedef struct {
+    uint32_t magic;
+    uint32_t count;                             /* exceptions since POR */
+    uint32_t valid;                             /* record not yet cleared by host */
+    uint32_t cause;                             /* CP0 Cause */
+    uint32_t epc;
+    uint32_t badVAddr;
+    uint32_t handlerSp;                         /* $sp in the C exception handler, below the saved context */
+    uint32_t uptimeMs;
+    uint32_t traceN;
+    FAULT_TRACE_ENTRY trace[FAULT_TRACE_LEN];   /* newest first */
+    FAULT_BEAT_ENTRY beat[FAULT_BEAT_COUNT];
+    FAULT_DROP_ENTRY drop;                      /* written live, not cleared by the host */
+} FAULT_RECORD;
+
+static FAULT_RECORD faultRec __attribute__((persistent));
+
+static void FAULT_Clear(void)
+{
+    faultRec.valid = 0u;
+    faultRec.cause = 0u;
+    faultRec.epc = 0u;
+    faultRec.badVAddr = 0u;
+    faultRec.handlerSp = 0u;
+    faultRec.uptimeMs = 0u;
+    faultRec.traceN = 0u;
+    for (unsigned i = 0u; i < FAULT_BEAT_COUNT; i++) faultRec.beat[i] = (FAULT_BEAT_ENTRY){ 0u, 0u, 0u, 0u };
+}
+
+void FAULT_Init(void)
+{
+    /* RAM content is undefined after power-on */
+    if ((faultRec.magic != FAULT_PERSIST_MAGIC) || (SUP_GetResetCause() == SUP_RESET_POR)) {
+        faultRec.magic = FAULT_PERSIST_MAGIC;
+        faultRec.count = 0u;
+        faultRec.drop = (FAULT_DROP_ENTRY){ 0u, 0u, 0u, 0u };
+        FAULT_Clear();
+    } else if (faultRec.drop.count != 0u && faultRec.drop.resets != 0xFFFFu) {
+        faultRec.drop.resets++;
+    }
+
+    faultHead = 0u;
+    faultN = 0u;
+    for (unsigned i = 0u; i < FAULT_BEAT_COUNT; i++) faultBeat[i] = (FAULT_BEAT_ENTRY){ 0u, 0u, 0u, 0u };
+}
+
+void FAULT_Trace(FAULT_EVENT ev, uint16_t arg)
+{
+    FAULT_TRACE_ENTRY *e = &faultRing[faultHead];
+
+    e->ms = myTime;
+    e->arg = arg;
+    e->ev = (uint8_t)ev;
+    e->rsv = 0u;
+
+    if (++faultHead >= FAULT_TRACE_LEN) faultHead = 0u;
+    if (faultN < FAULT_TRACE_LEN) faultN++;
+}
+
+void FAULT_Beat(FAULT_BEAT b, uint16_t arg)
+{
+    FAULT_BEAT_ENTRY *e = &faultBeat[(unsigned)b % FAULT_BEAT_COUNT];
+
+    e->ms = myTime;
+    e->count++;
+    e->arg = arg;
+}
+
+void FAULT_SupplyDrop(uint16_t started, uint16_t minMv)
+{
+    if (started != 0u) {
+        faultRec.drop.count += started;
+        faultRec.drop.ms = myTime;
+        faultRec.drop.resets = 0u;
+    }
+    faultRec.drop.minMv = minMv;
+}
+
+void FAULT_Capture(uint32_t cause, uint32_t epc, uint32_t badVAddr, uint32_t handlerSp)
+{
+    uint8_t idx = faultHead;
+
+    faultRec.magic = FAULT_PERSIST_MAGIC;
+    faultRec.count++;
+    faultRec.valid = 1u;
+    faultRec.cause = cause;
+    faultRec.epc = epc;
+    faultRec.badVAddr = badVAddr;
+    faultRec.handlerSp = handlerSp;
+    faultRec.uptimeMs = myTime;
+    faultRec.traceN = faultN;
+
+    for (uint8_t i = 0u; i < faultN; i++) {
+        idx = (idx == 0u) ? (uint8_t)(FAULT_TRACE_LEN - 1u) : (uint8_t)(idx - 1u);
+        faultRec.trace[i] = faultRing[idx];
+    }
+    for (unsigned i = 0u; i < FAULT_BEAT_COUNT; i++) faultRec.beat[i] = faultBeat[i];
+
+    /* Software reset */
+    SYSKEY = 0x00000000U;
+    SYSKEY = 0xAA996655U;
+    SYSKEY = 0x556699AAU;
+    RSWRSTSET = _RSWRST_SWRST_MASK;
+    (void)RSWRST;
+
+    while (true) {
+    }
+}
+
+static void FAULT_Put32(uint32_t reg, uint32_t v)
+{
+    MBS_InputRegisters[reg] = (uint16_t)(v >> 16);
+    MBS_InputRegisters[reg + 1u] = (uint16_t)v;
+}
+
+void FAULT_Task_250ms(void)
+{
+    if (MBS_RegIsBitsSet(MBS_HoldRegisters[MBS_DIAG_COMMAND], MBS_DIAG_CMD_CLEAR_FAULT)) {
+        FAULT_Clear();
+        MBS_RegClearBits(&MBS_HoldRegisters[MBS_DIAG_COMMAND], MBS_DIAG_CMD_CLEAR_FAULT);
+    }
+
+    MBS_InputRegisters[MBS_IR_FAULT_VALID]   = (uint16_t)faultRec.valid;
+    MBS_InputRegisters[MBS_IR_FAULT_COUNT]   = (uint16_t)faultRec.count;
+    MBS_InputRegisters[MBS_IR_FAULT_EXCCODE] = (uint16_t)((faultRec.cause & 0x0000007CU) >> 2U);
+    FAULT_Put32(MBS_IR_FAULT_EPC_HI, faultRec.epc);
+    FAULT_Put32(MBS_IR_FAULT_BADVADDR_HI, faultRec.badVAddr);
+    FAULT_Put32(MBS_IR_FAULT_HANDLER_SP_HI, faultRec.handlerSp);
+    FAULT_Put32(MBS_IR_FAULT_UPTIME_HI, faultRec.uptimeMs);
+    MBS_InputRegisters[MBS_IR_FAULT_TRACE_N] = (uint16_t)faultRec.traceN;
+
+    for (unsigned i = 0u; i < FAULT_TRACE_LEN; i++) {
+        volatile uint16_t *r = &MBS_InputRegisters[MBS_IR_FAULT_TRACE + i * MBS_IR_FAULT_TRACE_STRIDE];
+        bool used = (i < faultRec.traceN);
+        uint32_t age = faultRec.uptimeMs - faultRec.trace[i].ms;
+
+        r[MBS_IR_FAULT_TRACE_EV]     = used ? (uint16_t)faultRec.trace[i].ev : 0u;
+        r[MBS_IR_FAULT_TRACE_ARG]    = used ? faultRec.trace[i].arg : 0u;
+        r[MBS_IR_FAULT_TRACE_AGE_MS] = used ? (uint16_t)((age > 0xFFFFu) ? 0xFFFFu : age) : 0u;
+    }
+
+    MBS_InputRegisters[MBS_IR_FAULT_DROP_COUNT]  = (uint16_t)faultRec.drop.count;
+    MBS_InputRegisters[MBS_IR_FAULT_DROP_RESETS] = faultRec.drop.resets;
+    FAULT_Put32(MBS_IR_FAULT_DROP_UPTIME_HI, faultRec.drop.ms);
+    MBS_InputRegisters[MBS_IR_FAULT_DROP_MIN_MV] = faultRec.drop.minMv;
+
+    for (unsigned i = 0u; i < FAULT_BEAT_COUNT; i++) {
+        volatile uint16_t *r = &MBS_InputRegisters[MBS_IR_FAULT_BEAT + i * MBS_IR_FAULT_BEAT_STRIDE];
+        bool used = (faultRec.valid != 0u) && (faultRec.beat[i].count != 0u);
+        uint32_t age = faultRec.uptimeMs - faultRec.beat[i].ms;
+
+        r[MBS_IR_FAULT_BEAT_COUNT]  = used ? (uint16_t)faultRec.beat[i].count : 0u;
+        r[MBS_IR_FAULT_BEAT_ARG]    = used ? faultRec.beat[i].arg : 0u;
+        r[MBS_IR_FAULT_BEAT_AGE_MS] = used ? (uint16_t)((age > 0xFFFFu) ? 0xFFFFu : age) : 0u;
+    }
+}
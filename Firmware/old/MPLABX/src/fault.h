@@ -0,0 +1,69 @@
+#ifndef FAULT_H
+#define FAULT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* =========================================================================
+ * Post-mortem fault capture
+ *
+ * A small trace ring (FAULT_Trace) records errors and state changes.
+ * Periodic activity only bumps a counter (FAULT_Beat), so it cannot push
+ * the events out of the ring. The general / bootstrap exception handler
+ * copies CP0 Cause, EPC, BadVAddr, the handler's SP, uptime, the beats
+ * and the last FAULT_TRACE_LEN trace events into a no-init (persistent)
+ * record and performs a software reset.
+ *
+ * After reboot the record is published in the input registers until it
+ * is cleared with MBS_DIAG_CMD_CLEAR_FAULT. The record is discarded on
+ * power-on reset.
+ *
+ * The last supply drop (FAULT_SupplyDrop) is written to the persistent
+ * record as it happens, so a brown-out reset that follows still shows
+ * it. It is kept until the next power-on reset, not cleared by the host.
+ * ========================================================================= */
+#define FAULT_TRACE_LEN     8u
+
+typedef enum {
+    FAULT_EV_NONE = 0,
+    FAULT_EV_BOOT,          /* arg: SUP_RESET_CAUSE */
+    FAULT_EV_MODBUS,        /* exception response, arg: function << 8 | MBS_ERROR_CODE_xx */
+    FAULT_EV_SUP_TRIP = 5,  /* arg: SUP_TASK_ID; 3 and 4 were periodic marks, see FAULT_BEAT */
+    FAULT_EV_SUPPLY_DROP    /* arg: MBS_PWR_DROP_LIMIT, mV */
+} FAULT_EVENT;
+
+/* Periodic activity: count, last argument and time, not traced */
+typedef enum {
+    FAULT_BEAT_MODBUS = 0,  /* request for us, arg: function << 8 | low byte of start register */
+    FAULT_BEAT_SLOW,        /* 1 s block, arg: 0 */
+    FAULT_BEAT_COUNT
+} FAULT_BEAT;
+
+/** Validate the persistent record. Call after SUP_Init(), before SYS_Initialize(). */
+void FAULT_Init(void);
+
+/** Append one event to the trace ring. Main loop context. */
+void FAULT_Trace(FAULT_EVENT ev, uint16_t arg);
+
+/** Count one periodic activity. Main loop context. */
+void FAULT_Beat(FAULT_BEAT b, uint16_t arg);
+
+/**
+ * Supply drop (pwrmon.c): 'started' new drops since the last call, 'minMv'
+ * the lowest supply of the last one so far. Main loop context.
+ */
+void FAULT_SupplyDrop(uint16_t started, uint16_t minMv);
+
+/**
+ * Handle MBS_DIAG_COMMAND (MBS_DIAG_CMD_CLEAR_FAULT) and publish the
+ * record to the input registers. Call at 250 ms cadence.
+ */
+void FAULT_Task_250ms(void);
+
+/**
+ * Called from the exception handlers in exceptions.c. Stores the record
+ * and resets the device, does not return.
+ */
+void __attribute__((noreturn)) FAULT_Capture(uint32_t cause, uint32_t epc, uint32_t badVAddr, uint32_t handlerSp);
+
+#endif /* FAULT_H */
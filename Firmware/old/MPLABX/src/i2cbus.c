@@ -0,0 +1,321 @@
+#include "definitions.h"
+#include "ModbusSlave.h"
+#include "i2cbus.h"
+
+/* ===================== Constants ===================== */
+#define I2CBUS_TICKS_PER_US     (CORE_TIMER_FREQUENCY / 1000000u)
+#define I2CBUS_HALF_BIT_TICKS   (5u * I2CBUS_TICKS_PER_US)         /* ~100 kHz */
+#define I2CBUS_STRETCH_TICKS    (1000u * I2CBUS_TICKS_PER_US)      /* SCL held low by a slave */
+#define I2CBUS_TPGD_NS          130u                                /* I2CxBRG formula, pulse gobbler delay */
+
+/* SDA = RB5, SCL = RC9, both open drain (ODCB/ODCC in plib_gpio.c) */
+#define I2CBUS_SDA_MASK         (1u << (SDA_PIN & 0xFu))
+#define I2CBUS_SCL_MASK         (1u << (SCL_PIN & 0xFu))
+
+/* ===================== State ===================== */
+static I2CBUS_Stats_t i2cbusStats;
+
+/* Queue: one FIFO per priority. Changed with interrupts off, or from the I2C1 ISR */
+static I2CBUS_Xfer_t *i2cbusHead[I2CBUS_PRIO_COUNT];
+static I2CBUS_Xfer_t *i2cbusTail[I2CBUS_PRIO_COUNT];
+static uint8_t i2cbusDepth = 0u;                    /* queued + active */
+static I2CBUS_Xfer_t * volatile i2cbusActive = NULL;
+static volatile bool i2cbusHold = false;            /* recovery running, start nothing */
+
+static volatile uint16_t i2cbusBrgNext = 0u;        /* 0 = no clock change pending */
+static uint16_t i2cbusClockKHz = I2CBUS_CLOCK_DEFAULT_KHZ;
+
+/* Timeout supervision, main loop */
+static I2CBUS_Xfer_t *i2cbusSeen = NULL;
+static uint32_t i2cbusSeenXfers = 0u;
+static uint32_t i2cbusSeenT = 0u;
+
+/* ===================== Queue ===================== */
+static I2CBUS_Xfer_t *I2CBUS_Pop(void)
+{
+    for (uint8_t p = 0u; p < (uint8_t)I2CBUS_PRIO_COUNT; p++) {
+        I2CBUS_Xfer_t *x = i2cbusHead[p];
+
+        if (x != NULL) {
+            i2cbusHead[p] = x->next;
+            if (i2cbusHead[p] == NULL) i2cbusTail[p] = NULL;
+            x->next = NULL;
+            return x;
+        }
+    }
+    return NULL;
+}
+
+static I2CBUS_ERR I2CBUS_MapError(I2C_ERROR e)
+{
+    if (e == I2C_ERROR_NACK) return I2CBUS_ERR_NACK;
+    if (e == I2C_ERROR_BUS_COLLISION) return I2CBUS_ERR_COLLISION;
+    return I2CBUS_ERR_NONE;
+}
+
+/* Transfer left the bus: result, statistics, client callback */
+static void I2CBUS_Finish(I2CBUS_Xfer_t *x, I2CBUS_ERR err)
+{
+    i2cbusDepth--;
+    i2cbusStats.xfers++;
+    if (err != I2CBUS_ERR_NONE) i2cbusStats.errors++;
+    if (err == I2CBUS_ERR_TIMEOUT) i2cbusStats.timeouts++;
+
+    x->error = (uint8_t)err;
+    x->state = (err == I2CBUS_ERR_NONE) ? I2CBUS_XFER_DONE : I2CBUS_XFER_FAILED;
+
+    if (x->callback != NULL) x->callback(x);
+}
+
+/*
+ * Start queued transfers until one is on the bus or the queue is empty.
+ * Interrupts off, or I2C1 ISR. Nested calls from a client callback that
+ * submits return at once on i2cbusActive.
+ */
+static void I2CBUS_StartNext(void)
+{
+    while (!i2cbusHold && i2cbusActive == NULL) {
+        I2CBUS_Xfer_t *x = I2CBUS_Pop();
+        bool ok;
+
+        if (x == NULL) return;
+
+        if (i2cbusBrgNext != 0u) {
+            /* Slew rate control at exactly 400 kHz, off otherwise (as I2C1_TransferSetup()) */
+            I2C1BRG = i2cbusBrgNext;
+            if (i2cbusClockKHz == 400u) I2C1CONCLR = _I2C1CON_DISSLW_MASK;
+            else                        I2C1CONSET = _I2C1CON_DISSLW_MASK;
+            i2cbusBrgNext = 0u;
+        }
+
+        i2cbusActive = x;
+        x->state = I2CBUS_XFER_ACTIVE;
+
+        if (x->wlen != 0u && x->rlen != 0u) ok = I2C1_WriteRead(x->addr, x->wbuf, x->wlen, x->rbuf, x->rlen);
+        else if (x->wlen != 0u)             ok = I2C1_Write(x->addr, x->wbuf, x->wlen);
+        else                                ok = I2C1_Read(x->addr, x->rbuf, x->rlen);
+
+        if (ok) return;
+
+        /* plib refused: a START is already on the bus (other master or stuck line) */
+        i2cbusActive = NULL;
+        I2CBUS_Finish(x, I2CBUS_ERR_COLLISION);
+    }
+}
+
+/* plib completion callback, I2C1 ISR context */
+static void I2CBUS_Callback(uintptr_t context)
+{
+    I2CBUS_Xfer_t *x = i2cbusActive;
+    I2C_ERROR err = I2C1_ErrorGet();
+
+    (void)context;
+
+    if (x == NULL) return;      /* aborted by I2CBUS_Recover() */
+
+    i2cbusActive = NULL;
+    I2CBUS_Finish(x, I2CBUS_MapError(err));
+    I2CBUS_StartNext();
+}
+
+void I2CBUS_Init(void)
+{
+    I2C1_CallbackRegister(I2CBUS_Callback, 0);
+}
+
+bool I2CBUS_Submit(I2CBUS_Xfer_t *x)
+{
+    if (x == NULL || I2CBUS_Pending(x)) return false;
+    if (x->prio >= (uint8_t)I2CBUS_PRIO_COUNT) return false;
+    if ((x->wbuf == NULL || x->wlen == 0u) && (x->rbuf == NULL || x->rlen == 0u)) return false;
+
+    bool irq = EVIC_INT_Disable();
+
+    if (x->wbuf == NULL) x->wlen = 0u;
+    if (x->rbuf == NULL) x->rlen = 0u;
+    x->error = (uint8_t)I2CBUS_ERR_NONE;
+    x->state = I2CBUS_XFER_QUEUED;
+    x->next = NULL;
+
+    if (i2cbusTail[x->prio] != NULL) i2cbusTail[x->prio]->next = x;
+    else                             i2cbusHead[x->prio] = x;
+    i2cbusTail[x->prio] = x;
+
+    if (++i2cbusDepth > i2cbusStats.queueMax) i2cbusStats.queueMax = i2cbusDepth;
+
+    I2CBUS_StartNext();
+
+    EVIC_INT_Restore(irq);
+    return true;
+}
+
+bool I2CBUS_SetClockKHz(uint16_t khz)
+{
+    if (khz < I2CBUS_CLOCK_MIN_KHZ || khz > I2CBUS_CLOCK_MAX_KHZ) return false;
+    if (khz == i2cbusClockKHz) return true;
+
+    /* I2CxBRG = (PBCLK / 2) * (1 / Fsck - Tpgd) - 1, PBCLK = SYSCLK on this part */
+    uint32_t half = CPU_CLOCK_FREQUENCY / 2u;
+    uint32_t brg = (uint32_t)(((uint64_t)half * (1000000u / khz - I2CBUS_TPGD_NS)) / 1000000000u) - 1u;
+
+    if (brg < 4u) return false;     /* plib limit, PBCLK too slow for this clock */
+
+    bool irq = EVIC_INT_Disable();
+    i2cbusClockKHz = khz;
+    i2cbusBrgNext = (uint16_t)brg;
+    I2CBUS_StartNext();             /* nothing queued: picked up by the next submit */
+    EVIC_INT_Restore(irq);
+    return true;
+}
+
+/* ===================== Bus recovery ===================== */
+static void I2CBUS_Wait(uint32_t ticks)
+{
+    uint32_t t0 = _CP0_GET_COUNT();
+
+    while ((uint32_t)(_CP0_GET_COUNT() - t0) < ticks) {
+    }
+}
+
+/* Release SCL and wait for it to go high (clock stretching) */
+static bool I2CBUS_SclHigh(void)
+{
+    uint32_t t0 = _CP0_GET_COUNT();
+
+    LATCSET = I2CBUS_SCL_MASK;
+    while (SCL_Get() == 0u) {
+        if ((uint32_t)(_CP0_GET_COUNT() - t0) > I2CBUS_STRETCH_TICKS) return false;
+    }
+    return true;
+}
+
+bool I2CBUS_Recover(void)
+{
+    uint32_t t0 = _CP0_GET_COUNT();
+    uint8_t clocks = 0u;
+    bool ok = true;
+
+    /* No completion or new start from here; submits only queue */
+    i2cbusHold = true;
+
+    /* Module off: the pins fall back to the port latches */
+    IEC2CLR = _IEC2_I2C1MIE_MASK | _IEC2_I2C1BCIE_MASK;
+    I2C1CONCLR = _I2C1CON_ON_MASK;
+
+    LATBSET = I2CBUS_SDA_MASK;
+    LATCSET = I2CBUS_SCL_MASK;
+    TRISBCLR = I2CBUS_SDA_MASK;
+    TRISCCLR = I2CBUS_SCL_MASK;
+    I2CBUS_Wait(I2CBUS_HALF_BIT_TICKS);
+
+    /* Clock out the rest of the byte the slave is sending or waiting to ACK */
+    while (SDA_Get() == 0u && clocks < I2CBUS_RECOVER_CLOCKS) {
+        LATCCLR = I2CBUS_SCL_MASK;
+        I2CBUS_Wait(I2CBUS_HALF_BIT_TICKS);
+        if (!I2CBUS_SclHigh()) {
+            ok = false;
+            break;
+        }
+        I2CBUS_Wait(I2CBUS_HALF_BIT_TICKS);
+        clocks++;
+    }
+
+    /* STOP: SDA low while SCL is low, SCL high, then SDA high */
+    if (ok) {
+        LATCCLR = I2CBUS_SCL_MASK;
+        I2CBUS_Wait(I2CBUS_HALF_BIT_TICKS);
+        LATBCLR = I2CBUS_SDA_MASK;
+        I2CBUS_Wait(I2CBUS_HALF_BIT_TICKS);
+        ok = I2CBUS_SclHigh();
+        I2CBUS_Wait(I2CBUS_HALF_BIT_TICKS);
+        LATBSET = I2CBUS_SDA_MASK;
+        I2CBUS_Wait(I2CBUS_HALF_BIT_TICKS);
+        ok = ok && (SCL_Get() != 0u) && (SDA_Get() != 0u);
+    }
+
+    /* Pins back to inputs, the module drives them once it is on */
+    LATBSET = I2CBUS_SDA_MASK;
+    LATCSET = I2CBUS_SCL_MASK;
+    TRISBSET = I2CBUS_SDA_MASK;
+    TRISCSET = I2CBUS_SCL_MASK;
+
+    /* Stale flags would run the plib state machine on the next start */
+    I2C1STATCLR = _I2C1STAT_BCL_MASK;
+    IFS2CLR = _IFS2_I2C1MIF_MASK | _IFS2_I2C1BCIF_MASK;
+    I2C1_TransferAbort();       /* idle state machine, module on */
+
+    uint32_t us = (uint32_t)(_CP0_GET_COUNT() - t0) / I2CBUS_TICKS_PER_US;
+
+    i2cbusStats.recoveries++;
+    if (!ok) i2cbusStats.fails++;
+    i2cbusStats.lastClocks = clocks;
+    i2cbusStats.lastUs = (uint16_t)((us > 0xFFFFu) ? 0xFFFFu : us);
+    if (i2cbusStats.lastUs > i2cbusStats.maxUs) i2cbusStats.maxUs = i2cbusStats.lastUs;
+
+    /* The interrupted transfer fails, the rest of the queue goes on */
+    bool irq = EVIC_INT_Disable();
+    I2CBUS_Xfer_t *x = i2cbusActive;
+
+    i2cbusActive = NULL;
+    i2cbusHold = false;
+    if (x != NULL) I2CBUS_Finish(x, I2CBUS_ERR_ABORTED);
+    I2CBUS_StartNext();
+    EVIC_INT_Restore(irq);
+
+    return ok;
+}
+
+bool I2CBUS_Task(uint32_t now_ms)
+{
+    I2CBUS_Xfer_t *x = i2cbusActive;
+    bool progress = (x == NULL) || (i2cbusStats.xfers != i2cbusSeenXfers);
+
+    if (x != i2cbusSeen || progress) {
+        i2cbusSeen = x;
+        i2cbusSeenXfers = i2cbusStats.xfers;
+        i2cbusSeenT = now_ms;
+        return progress;
+    }
+
+    /* Same transfer active for too long: lost interrupt or a stuck slave */
+    if ((uint32_t)(now_ms - i2cbusSeenT) > I2CBUS_XFER_TIMEOUT_MS) {
+        bool irq = EVIC_INT_Disable();
+
+        if (i2cbusActive == x) {
+            i2cbusActive = NULL;
+            i2cbusHold = true;          /* Recover() restarts the queue */
+            I2CBUS_Finish(x, I2CBUS_ERR_TIMEOUT);
+        }
+        EVIC_INT_Restore(irq);
+
+        if (i2cbusHold) (void)I2CBUS_Recover();
+        i2cbusSeen = NULL;
+    }
+    return false;
+}
+
+void I2CBUS_GetStats(I2CBUS_Stats_t *out)
+{
+    if (out != NULL) {
+        *out = i2cbusStats;
+    }
+}
+
+void I2CBUS_Task_250ms(void)
+{
+    uint16_t khz = MBS_HoldRegisters[MBS_I2C_CLOCK_KHZ];
+
+    if (khz != i2cbusClockKHz && !I2CBUS_SetClockKHz(khz)) {
+        MBS_HoldRegisters[MBS_I2C_CLOCK_KHZ] = i2cbusClockKHz;     /* refused, show what runs */
+    }
+
+    MBS_InputRegisters[MBS_IR_I2C_RECOVERIES]     = (uint16_t)i2cbusStats.recoveries;
+    MBS_InputRegisters[MBS_IR_I2C_RECOVER_FAILS]  = (uint16_t)i2cbusStats.fails;
+    MBS_InputRegisters[MBS_IR_I2C_RECOVER_CLKS]   = i2cbusStats.lastClocks;
+    MBS_InputRegisters[MBS_IR_I2C_RECOVER_US]     = i2cbusStats.lastUs;
+    MBS_InputRegisters[MBS_IR_I2C_RECOVER_MAX_US] = i2cbusStats.maxUs;
+    MBS_InputRegisters[MBS_IR_I2CQ_XFERS]         = (uint16_t)i2cbusStats.xfers;
+    MBS_InputRegisters[MBS_IR_I2CQ_ERRORS]        = (uint16_t)i2cbusStats.errors;
+    MBS_InputRegisters[MBS_IR_I2CQ_TIMEOUTS]      = (uint16_t)i2cbusStats.timeouts;
+    MBS_InputRegisters[MBS_IR_I2CQ_DEPTH_MAX]     = i2cbusStats.queueMax;
+}
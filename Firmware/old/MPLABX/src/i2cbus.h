@@ -0,0 +1,137 @@
+#ifndef I2CBUS_H
+#define I2CBUS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* =========================================================================
+ * I2C1 bus services on top of plib_i2c1_master
+ *
+ * Transaction queue: every client owns its I2CBUS_Xfer_t descriptors and
+ * hands them to I2CBUS_Submit(). Transfers run one at a time, highest
+ * priority first and FIFO within a priority. The next one is started
+ * from the I2C1 interrupt right after the previous STOP, so back-to-back
+ * transfers need no main loop pass. The plib callback belongs to this
+ * module; clients get their own callback per descriptor, or poll state.
+ *
+ * Bus recovery: a slave that was interrupted mid-byte can hold SDA low
+ * forever, and the master then sees a busy bus or bus collisions on
+ * every start. I2CBUS_Recover() turns the module off, clocks SCL by hand
+ * (open drain, ~100 kHz, clock stretching honoured) until the slave
+ * releases SDA, generates a STOP and hands the pins back to the module.
+ * The slave keeps its register contents, so the caller can go on reading
+ * without reconfiguring it.
+ * ========================================================================= */
+#define I2CBUS_RECOVER_CLOCKS       9u      /* one byte + ACK */
+#define I2CBUS_XFER_TIMEOUT_MS      25u     /* active transfer without completion */
+
+/* Bus clock, MBS_I2C_CLOCK_KHZ. The default is the MCC setting. */
+#define I2CBUS_CLOCK_DEFAULT_KHZ    50u
+#define I2CBUS_CLOCK_MIN_KHZ        10u
+#define I2CBUS_CLOCK_MAX_KHZ        1000u   /* Fast-mode Plus */
+
+typedef enum {
+    I2CBUS_PRIO_HIGH = 0,       /* periodic sensor reads */
+    I2CBUS_PRIO_NORMAL,         /* configuration */
+    I2CBUS_PRIO_LOW,            /* bulk (EEPROM/flash) */
+    I2CBUS_PRIO_COUNT
+} I2CBUS_PRIO;
+
+typedef enum {
+    I2CBUS_XFER_IDLE = 0,       /* never submitted */
+    I2CBUS_XFER_QUEUED,
+    I2CBUS_XFER_ACTIVE,
+    I2CBUS_XFER_DONE,
+    I2CBUS_XFER_FAILED          /* error holds the reason */
+} I2CBUS_XFER_STATE;
+
+typedef enum {
+    I2CBUS_ERR_NONE = 0,
+    I2CBUS_ERR_NACK,
+    I2CBUS_ERR_COLLISION,       /* bus collision, or the bus was not free at start */
+    I2CBUS_ERR_TIMEOUT,         /* no completion within I2CBUS_XFER_TIMEOUT_MS */
+    I2CBUS_ERR_ABORTED          /* I2CBUS_Recover() while active */
+} I2CBUS_ERR;
+
+typedef struct I2CBUS_Xfer I2CBUS_Xfer_t;
+
+/*
+ * Completion callback. Runs in the I2C1 ISR (IPL3), or in the caller's
+ * context when a transfer ends through I2CBUS_Recover() or the timeout.
+ * The descriptor can be submitted again from inside the callback.
+ */
+typedef void (*I2CBUS_CALLBACK)(I2CBUS_Xfer_t *x);
+
+struct I2CBUS_Xfer {
+    /* set by the client */
+    uint16_t addr;
+    uint8_t *wbuf;              /* write phase, NULL/0 = none */
+    uint8_t  wlen;
+    uint8_t *rbuf;              /* read phase after a repeated start, NULL/0 = none */
+    uint8_t  rlen;
+    uint8_t  prio;              /* I2CBUS_PRIO */
+    I2CBUS_CALLBACK callback;   /* NULL: poll state */
+    uintptr_t context;
+
+    /* owned by i2cbus.c */
+    volatile uint8_t state;     /* I2CBUS_XFER_STATE */
+    volatile uint8_t error;     /* I2CBUS_ERR */
+    I2CBUS_Xfer_t *next;
+};
+
+typedef struct
+{
+    uint32_t recoveries;    /* I2CBUS_Recover() calls */
+    uint32_t fails;         /* bus still held afterwards */
+    uint8_t  lastClocks;    /* SCL pulses until SDA was released, last run */
+    uint16_t lastUs;        /* duration of the last run */
+    uint16_t maxUs;
+
+    uint32_t xfers;         /* transfers completed, any result */
+    uint32_t errors;        /* of those, failed */
+    uint32_t timeouts;
+    uint8_t  queueMax;      /* deepest queue seen, active transfer included */
+} I2CBUS_Stats_t;
+
+/** Take over the plib callback. Call once after SYS_Initialize(). */
+void I2CBUS_Init(void);
+
+/**
+ * Queue a transfer, any context. False if the descriptor is still queued
+ * or active, or has nothing to transfer.
+ */
+bool I2CBUS_Submit(I2CBUS_Xfer_t *x);
+
+/** True while the descriptor is queued or active. */
+static inline bool I2CBUS_Pending(const I2CBUS_Xfer_t *x)
+{
+    return (x->state == I2CBUS_XFER_QUEUED) || (x->state == I2CBUS_XFER_ACTIVE);
+}
+
+/**
+ * Bus clock in kHz (I2CBUS_CLOCK_MIN_KHZ..I2CBUS_CLOCK_MAX_KHZ), applied
+ * between two transfers. False if out of range.
+ */
+bool I2CBUS_SetClockKHz(uint16_t khz);
+
+/**
+ * Free a stuck bus (blocking, ~100 us, at most ~2 ms with a stretching
+ * slave). An active transfer ends with I2CBUS_ERR_ABORTED, the queue
+ * goes on afterwards. Main loop context. True when SCL and SDA are both
+ * high afterwards.
+ */
+bool I2CBUS_Recover(void);
+
+/**
+ * Transfer timeout supervision. Main loop, every few ms. True while the
+ * queue makes progress (idle, or a transfer completed since the last call).
+ */
+bool I2CBUS_Task(uint32_t now_ms);
+
+void I2CBUS_GetStats(I2CBUS_Stats_t *out);
+
+/** Apply MBS_I2C_CLOCK_KHZ and publish the statistics. Call at 250 ms cadence. */
+void I2CBUS_Task_250ms(void);
+
+#endif /* I2CBUS_H */
@@ -0,0 +1,140 @@
+#include <string.h>
+#include "definitions.h"
+#include "ModbusSlave.h"
+#include "endstop.h"
+#include "inhibit.h"
+
+/* Written from the detecting ISRs and the main loop, interrupts disabled */
+static volatile uint16_t inhLatched = 0u;
+static volatile uint16_t inhActive = 0u;
+static volatile uint16_t inhReleased = 0u;  /* acked while active, trips again once clear */
+static uint16_t inhRule[INHIBIT_RULES];
+
+static inline void INH_Drive(bool high)
+{
+    if (high) {
+        INHIBIT_PIN_SET(INHIBIT_PIN_MASK);
+    } else {
+        INHIBIT_PIN_CLR(INHIBIT_PIN_MASK);
+    }
+}
+
+/* New state of the sources in 'src', interrupts disabled */
+static void INH_Update(uint16_t src, uint16_t on)
+{
+    const uint16_t trip = (uint16_t)(on & ~inhReleased);
+
+    inhActive = (uint16_t)((inhActive & ~src) | on);
+    inhReleased &= inhActive;
+
+    if (trip != 0u) {
+        inhLatched |= trip;
+        INH_Drive(INHIBIT_LEVEL != 0u);
+        MBS_RegSetBits(&MBS_HoldRegisters[MBS_SL_STATUS], MBS_SL_STATUS_ALARM);
+    }
+}
+
+static uint16_t INH_RulesHit(uint8_t active)
+{
+    uint16_t hit = 0u;
+
+    for (uint8_t r = 0u; r < INHIBIT_RULES; r++) {
+        const uint8_t in = (uint8_t)(inhRule[r] & INHIBIT_RULE_INPUTS);
+
+        if (in == 0u) continue;
+        if ((inhRule[r] & INHIBIT_RULE_ALL) ? ((active & in) == in) : ((active & in) != 0u)) {
+            hit |= INHIBIT_SRC_RULE(r);
+        }
+    }
+    return hit;
+}
+
+void INHIBIT_Init(void)
+{
+    bool irq = EVIC_INT_Disable();
+
+    inhLatched = 0u;
+    inhActive = 0u;
+    inhReleased = 0u;
+    INHIBIT_GetDefaultRules(inhRule);
+    EVIC_INT_Restore(irq);
+}
+
+void INHIBIT_Set(uint16_t src, bool active)
+{
+    bool irq = EVIC_INT_Disable();
+
+    INH_Update(src, active ? src : 0u);
+    EVIC_INT_Restore(irq);
+}
+
+uint16_t INHIBIT_Latched(void)
+{
+    return inhLatched;
+}
+
+void INHIBIT_OnEndstops(uint8_t active)
+{
+    INH_Update(INHIBIT_SRC_RULES, INH_RulesHit(active));
+}
+
+void INHIBIT_GetDefaultRules(uint16_t rule[INHIBIT_RULES])
+{
+    memset(rule, 0, INHIBIT_RULES * sizeof(rule[0]));
+}
+
+void INHIBIT_SetRules(const uint16_t rule[INHIBIT_RULES])
+{
+    uint8_t active = 0u;
+    bool irq;
+
+    for (uint8_t i = 0u; i < ENDSTOP_COUNT; i++) {
+        if (ENDSTOP_IsActive((endstop_id_t)i)) active |= (uint8_t)(1u << i);
+    }
+
+    irq = EVIC_INT_Disable();
+    for (uint8_t r = 0u; r < INHIBIT_RULES; r++) {
+        inhRule[r] = (rule[r] & INHIBIT_RULE_INPUTS) ? (uint16_t)(rule[r] & (INHIBIT_RULE_INPUTS | INHIBIT_RULE_ALL)) : 0u;
+    }
+    /* A new rule that already holds trips now */
+    INHIBIT_OnEndstops(active);
+    EVIC_INT_Restore(irq);
+}
+
+void INHIBIT_GetRules(uint16_t rule[INHIBIT_RULES])
+{
+    bool irq = EVIC_INT_Disable();
+
+    memcpy(rule, inhRule, sizeof(inhRule));
+    EVIC_INT_Restore(irq);
+}
+
+void INHIBIT_Task_1ms(void)
+{
+    uint16_t ack = MBS_HoldRegisters[MBS_INHIBIT_ACK];
+    uint16_t rel;
+    bool irq;
+
+    if (ack != 0u) MBS_HoldRegisters[MBS_INHIBIT_ACK] = 0u;
+
+    irq = EVIC_INT_Disable();
+
+    /* A source that is still active stays latched, except the endstop rules */
+    rel = (uint16_t)(ack & inhLatched & (~inhActive | INHIBIT_SRC_RULES));
+    inhReleased |= (uint16_t)(rel & inhActive);
+    inhLatched &= (uint16_t)~rel;
+
+    if (inhLatched != 0u) {
+        INH_Drive(INHIBIT_LEVEL != 0u);
+        /* The main loop clears MBS_SL_STATUS on a command timeout */
+        MBS_RegSetBits(&MBS_HoldRegisters[MBS_SL_STATUS], MBS_SL_STATUS_ALARM);
+    } else {
+        INH_Drive(MBS_HoldRegisters[MBS_X5_FA] != 0u);
+        MBS_RegClearBits(&MBS_HoldRegisters[MBS_SL_STATUS], MBS_SL_STATUS_ALARM);
+    }
+    EVIC_INT_Restore(irq);
+
+    MBS_InputRegisters[MBS_IR_INH_LATCHED]  = inhLatched;
+    MBS_InputRegisters[MBS_IR_INH_ACTIVE]   = inhActive;
+    MBS_InputRegisters[MBS_IR_INH_RELEASED] = inhReleased;
+}
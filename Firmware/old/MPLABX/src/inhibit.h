@@ -0,0 +1,78 @@
+#ifndef INHIBIT_H
+#define INHIBIT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* =========================================================================
+ * Motor inhibit on the X5 FA output (PIC pin 41 / RC14)
+ *
+ * Safety sources report their condition with INHIBIT_Set() straight from
+ * the interrupt that detects it. The first report latches the source
+ * and drives the output to INHIBIT_LEVEL in the same call. The latch
+ * also sets MBS_SL_STATUS_ALARM. It is only released by the host:
+ * writing the source bit to MBS_INHIBIT_ACK clears a latch whose
+ * condition has gone. While no source is latched the output follows
+ * MBS_X5_FA as before.
+ *
+ * Endstop rules are checked in the change notice ISR on every accepted
+ * level (INHIBIT_OnEndstops()), so the driver's E-stop / limit input sees
+ * the output a few microseconds after the edge. A rule latch can be
+ * released while its inputs are still active, otherwise the axis could
+ * never be moved off the endstop; the rule trips again only after it
+ * has cleared.
+ * ========================================================================= */
+#define INHIBIT_SRC_SUPPLY      0x0001u     /* pwrmon.c: supply below MBS_PWR_DROP_LIMIT */
+#define INHIBIT_SRC_RULE(r)     ((uint16_t)(0x0100u << (r)))    /* endstop rule r */
+#define INHIBIT_SRC_RULES       0x0F00u
+
+/* Endstop rule, one word per rule (MBS_INHIBIT_RULE_BASE). 0 = rule off. */
+#define INHIBIT_RULES           4u
+#define INHIBIT_RULE_INPUTS     0x000Fu     /* bit per endstop_id_t */
+#define INHIBIT_RULE_ALL        0x8000u     /* all inputs of the mask active, else any one */
+
+/* Output: the driver's E-stop / limit input is wired here */
+#ifndef INHIBIT_PIN_MASK
+#define INHIBIT_PIN_SET(m)      (LATCSET = (m))
+#define INHIBIT_PIN_CLR(m)      (LATCCLR = (m))
+#define INHIBIT_PIN_MASK        (1u << 14)  /* RC14, X5 FA */
+#endif
+
+/* Output level that stops the driver (E-stop input, 0x00AD in the ADM driver) */
+#ifndef INHIBIT_LEVEL
+#define INHIBIT_LEVEL           1u
+#endif
+
+void INHIBIT_Init(void);
+
+/** Report a source condition. Any context; interrupts are disabled inside. */
+void INHIBIT_Set(uint16_t src, bool active);
+
+/** Latched sources (bit mask). */
+uint16_t INHIBIT_Latched(void);
+
+/**
+ * New endstop levels, bit per endstop_id_t (true = active). Change notice
+ * ISR or interrupts disabled; called by endstop.c.
+ */
+void INHIBIT_OnEndstops(uint8_t active);
+
+/** Factory rules: all off, X5 FA only follows MBS_X5_FA. */
+void INHIBIT_GetDefaultRules(uint16_t rule[INHIBIT_RULES]);
+
+/**
+ * Replace the endstop rules and check them against the present levels.
+ * Unknown bits are dropped, a rule without inputs is off. Main loop.
+ */
+void INHIBIT_SetRules(const uint16_t rule[INHIBIT_RULES]);
+
+/** Rules in use, after the limits of INHIBIT_SetRules(). */
+void INHIBIT_GetRules(uint16_t rule[INHIBIT_RULES]);
+
+/**
+ * Call from main loop at 1 ms. Handles MBS_INHIBIT_ACK, drives the output
+ * from MBS_X5_FA when nothing is latched and keeps MBS_SL_STATUS_ALARM.
+ */
+void INHIBIT_Task_1ms(void);
+
+#endif /* INHIBIT_H */
@@ -0,0 +1,68 @@
+#include "inputs.h"
+
+static DEBOUNCE_t inDb[INPUTS_WORDS];
+static uint32_t   inChanged[INPUTS_WORDS];
+
+#define INPUTS_BIT(pin)     (1uL << ((uint32_t)(pin) & 31u))
+#define INPUTS_WORD(pin)    ((uint8_t)((uint32_t)(pin) >> 5))
+
+static uint32_t INPUTS_Sample(uint8_t word)
+{
+    if (word == 0u) return (PORTA & 0xFFFFu) | ((PORTB & 0xFFFFu) << 16);
+    return (PORTC & 0xFFFFu) | ((PORTD & 0xFFFFu) << 16);
+}
+
+void INPUTS_Init(void)
+{
+    const uint32_t tris[INPUTS_WORDS] = {
+        (TRISA & 0xFFFFu) | ((TRISB & 0xFFFFu) << 16),
+        (TRISC & 0xFFFFu) | ((TRISD & 0xFFFFu) << 16),
+    };
+
+    for (uint8_t w = 0u; w < INPUTS_WORDS; w++) {
+        DEBOUNCE_Init(&inDb[w], INPUTS_Sample(w), tris[w]);
+        DEBOUNCE_SetLength(&inDb[w], 0xFFFFFFFFu, INPUTS_DEBOUNCE_DEFAULT_MS);
+        inChanged[w] = 0u;
+    }
+
+    INPUTS_SetDebounce(SW1_1_PIN, INPUTS_DEBOUNCE_SWITCH_MS);
+    INPUTS_SetDebounce(SW1_2_PIN, INPUTS_DEBOUNCE_SWITCH_MS);
+    INPUTS_SetDebounce(SW1_4_PIN, INPUTS_DEBOUNCE_SWITCH_MS);
+    INPUTS_SetDebounce(SW1_8_PIN, INPUTS_DEBOUNCE_SWITCH_MS);
+
+    INPUTS_SetDebounce(VERT_G_PIN, 1u);
+    INPUTS_SetDebounce(VERT_B_PIN, 1u);
+    INPUTS_SetDebounce(FOCUS_G_PIN, 1u);
+    INPUTS_SetDebounce(FOCUS_B_PIN, 1u);
+}
+
+void INPUTS_Task_1ms(void)
+{
+    for (uint8_t w = 0u; w < INPUTS_WORDS; w++) {
+        inChanged[w] = DEBOUNCE_Run(&inDb[w], INPUTS_Sample(w));
+    }
+}
+
+bool INPUTS_Get(GPIO_PIN pin)
+{
+    uint8_t w = INPUTS_WORD(pin);
+
+    return (w < INPUTS_WORDS) && ((inDb[w].state & INPUTS_BIT(pin)) != 0u);
+}
+
+uint32_t INPUTS_GetWord(uint8_t word)
+{
+    return (word < INPUTS_WORDS) ? inDb[word].state : 0u;
+}
+
+uint32_t INPUTS_GetChanged(uint8_t word)
+{
+    return (word < INPUTS_WORDS) ? inChanged[word] : 0u;
+}
+
+void INPUTS_SetDebounce(GPIO_PIN pin, uint8_t ms)
+{
+    uint8_t w = INPUTS_WORD(pin);
+
+    if (w < INPUTS_WORDS) DEBOUNCE_SetLength(&inDb[w], INPUTS_BIT(pin), ms);
+}
@@ -0,0 +1,45 @@
+#ifndef INPUTS_H
+#define INPUTS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "definitions.h"
+#include "debounce.h"
+
+/* =========================================================================
+ * Debounced digital inputs, all ports
+ *
+ * PORTA..PORTD are sampled every ms as two 32-bit words (A | B << 16 and
+ * C | D << 16) and run through the vertical counter engine in debounce.c,
+ * so adding inputs (backplane R5 panel, BP-002/BP-007 I/O) does not add to
+ * the 1 ms cost. Only pins configured as inputs (TRIS at INPUTS_Init())
+ * are debounced; outputs read back their pin level.
+ *
+ * Pins are addressed with the MCC GPIO_PIN values (GPIO_PIN_RC3 etc.):
+ * word = pin >> 5, bit = pin & 31.
+ *
+ * The endstops have their own change notice path (endstop.c) and run
+ * here with length 1, for the port view only.
+ * ========================================================================= */
+#define INPUTS_WORDS                2u
+#define INPUTS_DEBOUNCE_DEFAULT_MS  5u
+#define INPUTS_DEBOUNCE_SWITCH_MS   20u     /* SW1 address switch */
+
+void INPUTS_Init(void);
+
+/** Main loop, every ms. */
+void INPUTS_Task_1ms(void);
+
+/** Debounced level (true = pin high). */
+bool INPUTS_Get(GPIO_PIN pin);
+
+/** Debounced levels of one word, bit = pin & 31. */
+uint32_t INPUTS_GetWord(uint8_t word);
+
+/** Inputs of one word that changed in the last INPUTS_Task_1ms(). */
+uint32_t INPUTS_GetChanged(uint8_t word);
+
+/** Debounce length in ms (1..DEBOUNCE_LEN_MAX) for one pin. */
+void INPUTS_SetDebounce(GPIO_PIN pin, uint8_t ms);
+
+#endif /* INPUTS_H */
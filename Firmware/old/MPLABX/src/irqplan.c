@@ -0,0 +1,65 @@
+#include <sys/attribs.h>
+#include "definitions.h"
+#include "endstop.h"
+#include "adcscan.h"
+#include "irqplan.h"
+
+/* IPCn holds 4 vectors, 8 bits each: subpriority 1:0, priority 4:2 */
+#define IPC_STRIDE          4u          /* words, IPCn / CLR / SET / INV */
+#define IPC_FIELD_MASK      0x1Fu
+
+static void IRQ_SetPriority(uint32_t vector, uint32_t pri, uint32_t sub)
+{
+    const uint32_t shift = 8u * (vector % 4u);
+
+    *(&IPC0CLR + IPC_STRIDE * (vector / 4u)) = IPC_FIELD_MASK << shift;
+    *(&IPC0SET + IPC_STRIDE * (vector / 4u)) = ((pri << 2) | sub) << shift;
+}
+
+void IRQPLAN_Hold(void)
+{
+    _CP0_SET_STATUS((_CP0_GET_STATUS() & ~_CP0_STATUS_IPL_MASK) | (7u << _CP0_STATUS_IPL_POSITION));
+}
+
+void IRQPLAN_Init(void)
+{
+    /* Unresolved once MCC has regenerated interrupts.c */
+    (void)*(const volatile uint8_t *)&IRQPLAN_IsrLevels;
+
+    IRQ_SetPriority(_CORE_TIMER_VECTOR, IRQPLAN_PRI_CORE_TIMER, 0u);
+    IRQ_SetPriority(_UART1_RX_VECTOR, IRQPLAN_PRI_UART1_RX, 0u);
+    IRQ_SetPriority(_UART1_TX_VECTOR, IRQPLAN_PRI_UART1_TX, 0u);
+    IRQ_SetPriority(_UART1_ERR_VECTOR, IRQPLAN_PRI_UART1_ERR, 0u);
+    IRQ_SetPriority(_I2C1_MASTER_VECTOR, IRQPLAN_PRI_I2C1, 0u);
+    IRQ_SetPriority(_I2C1_BUS_VECTOR, IRQPLAN_PRI_I2C1, 0u);
+    IRQ_SetPriority(_CHANGE_NOTICE_B_VECTOR, IRQPLAN_PRI_ENDSTOP, 0u);
+    IRQ_SetPriority(_CHANGE_NOTICE_C_VECTOR, IRQPLAN_PRI_ENDSTOP, 0u);
+    IRQ_SetPriority(_CHANGE_NOTICE_D_VECTOR, IRQPLAN_PRI_ENDSTOP, 0u);
+    IRQ_SetPriority(_DMA0_VECTOR, IRQPLAN_PRI_ADCSCAN, 0u);
+
+    /* Anything pending since SYS_Initialize() now runs at its own level */
+    _CP0_SET_STATUS(_CP0_GET_STATUS() & ~_CP0_STATUS_IPL_MASK);
+}
+
+/* Endstops (endstop.c). Not in DIAG_IsrStat: the handler timestamps every
+ * edge itself, and the ISR statistics block is full. */
+void __attribute__((used)) __ISR(_CHANGE_NOTICE_B_VECTOR, ipl4SOFT) CHANGE_NOTICE_B_Handler (void)
+{
+    ENDSTOP_CN_InterruptHandler();
+}
+
+void __attribute__((used)) __ISR(_CHANGE_NOTICE_C_VECTOR, ipl4SOFT) CHANGE_NOTICE_C_Handler (void)
+{
+    ENDSTOP_CN_InterruptHandler();
+}
+
+void __attribute__((used)) __ISR(_CHANGE_NOTICE_D_VECTOR, ipl4SOFT) CHANGE_NOTICE_D_Handler (void)
+{
+    ENDSTOP_CN_InterruptHandler();
+}
+
+/* ADC scan moved by DMA (adcscan.c), supply drop watch. Same level as the endstops. */
+void __attribute__((used)) __ISR(_DMA0_VECTOR, ipl4SOFT) DMA0_Handler (void)
+{
+    ADCSCAN_DMA_InterruptHandler();
+}
@@ -0,0 +1,44 @@
+#ifndef IRQPLAN_H
+#define IRQPLAN_H
+
+#include <stdint.h>
+
+/* =========================================================================
+ * Interrupt priorities
+ *
+ * MCC generates every source at priority 1. IRQPLAN_Init() sets the plan
+ * below over that, highest first:
+ *   7  UART1_RX     shadow register set 1 (PRISS, MCC), no context save
+ *   6  UART1_ERR    overrun must be cleared before RX stalls
+ *   5  UART1_TX
+ *   4  CHANGE_NOTICE_B/C/D  endstops, DMA0  ADC scan / supply drop
+ *   3  I2C1_MASTER / I2C1_BUS
+ *   2  CORE_TIMER   1 ms tick: flags, plus the TLV493D, endstop and port
+ *                   snapshot ticks. The TLV493D one submits I2C transfers,
+ *                   hence below I2C1.
+ *
+ * The CN and DMA0 handlers live in irqplan.c. The MCC sources keep their
+ * handlers in the generated interrupts.c, whose __ISR() levels are edited
+ * to match; see IRQPLAN_IsrLevels.
+ * ========================================================================= */
+#define IRQPLAN_PRI_UART1_RX    7u
+#define IRQPLAN_PRI_UART1_ERR   6u
+#define IRQPLAN_PRI_UART1_TX    5u
+#define IRQPLAN_PRI_ENDSTOP     4u
+#define IRQPLAN_PRI_ADCSCAN     4u
+#define IRQPLAN_PRI_I2C1        3u
+#define IRQPLAN_PRI_CORE_TIMER  2u
+
+/* Defined in interrupts.c next to the __ISR() levels of the plan. An MCC
+ * regeneration drops it, and the link fails instead of running these
+ * priorities against the MCC levels. */
+extern const uint8_t IRQPLAN_IsrLevels;
+
+/** Mask all interrupts at the CPU (IPL 7). Call before SYS_Initialize(),
+ *  which enables them at the MCC priorities. */
+void IRQPLAN_Hold(void);
+
+/** Set the priorities above and unmask. Call right after SYS_Initialize(). */
+void IRQPLAN_Init(void);
+
+#endif /* IRQPLAN_H */
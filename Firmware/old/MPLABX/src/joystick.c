@@ -0,0 +1,136 @@
+#include "definitions.h"
+#include "ModbusSlave.h"
+#include "joystick.h"
+
+#define JS_Q                12          /* normalized stick position, 1 << JS_Q = full */
+#define JS_RATE_SHIFT       8           /* speed fraction for the rate limit */
+
+typedef struct {
+    uint16_t fullScale;     /* 1..INT16_MAX */
+    uint16_t deadband;      /* < fullScale */
+    uint16_t expo;          /* 0..100 % */
+    uint16_t rampMs;        /* 0 = off */
+    uint16_t maxSpeed;      /* 0..JOYSTICK_SPEED_MAX */
+} JS_SETUP;
+
+static const uint16_t jsInputReg[JOYSTICK_AXES] = {
+    [JOYSTICK_HORIZ] = MBS_HORIZ_INPUT,
+    [JOYSTICK_VERT]  = MBS_VERT_INPUT,
+    [JOYSTICK_FOCUS] = MBS_FOCUS_INPUT,
+};
+
+static int32_t jsSpeed[JOYSTICK_AXES];      /* << JS_RATE_SHIFT */
+
+static uint16_t JS_Limit(uint16_t reg, uint16_t lo, uint16_t hi)
+{
+    uint16_t v = MBS_HoldRegisters[reg];
+
+    if (v < lo) v = lo;
+    if (v > hi) v = hi;
+    /* Refused values are replaced by the one in use */
+    if (v != MBS_HoldRegisters[reg]) MBS_HoldRegisters[reg] = v;
+    return v;
+}
+
+static void JS_ReadSetup(JS_SETUP *s)
+{
+    s->fullScale = JS_Limit(MBS_JS_FULL_SCALE, 1u, (uint16_t)INT16_MAX);
+    s->deadband  = JS_Limit(MBS_JS_DEADBAND, 0u, (uint16_t)(s->fullScale - 1u));
+    s->expo      = JS_Limit(MBS_JS_EXPO, 0u, 100u);
+    s->rampMs    = MBS_HoldRegisters[MBS_JS_RAMP_MS];
+    s->maxSpeed  = JS_Limit(MBS_JS_MAX_SPEED, 0u, JOYSTICK_SPEED_MAX);
+}
+
+/* Stick position to signed target speed */
+static int32_t JS_Shape(int16_t in, const JS_SETUP *s)
+{
+    uint32_t mag = (in < 0) ? (uint32_t)(-(int32_t)in) : (uint32_t)in;
+    uint32_t x;
+
+    if (mag <= s->deadband) return 0;
+    if (mag > s->fullScale) mag = s->fullScale;
+
+    x = ((mag - s->deadband) << JS_Q) / (uint32_t)(s->fullScale - s->deadband);
+    if (s->expo != 0u) {
+        const uint32_t x3 = (((x * x) >> JS_Q) * x) >> JS_Q;
+
+        x = (x * (100u - s->expo) + x3 * s->expo) / 100u;
+    }
+    x = (x * s->maxSpeed + (1u << (JS_Q - 1))) >> JS_Q;
+
+    return (in < 0) ? -(int32_t)x : (int32_t)x;
+}
+
+/* Only speeding up is limited */
+static int32_t JS_Ramp(int32_t cur, int32_t tgt, int32_t step)
+{
+    if ((cur > 0 && tgt < cur) || (cur < 0 && tgt > cur)) {
+        if ((cur > 0 && tgt >= 0) || (cur < 0 && tgt <= 0)) return tgt;
+        cur = 0;
+    }
+    if (step == 0) return tgt;
+
+    if (tgt > cur) return (tgt - cur > step) ? cur + step : tgt;
+    if (tgt < cur) return (cur - tgt > step) ? cur - step : tgt;
+    return cur;
+}
+
+/* ADM jog command word (0x00CA), decelerate stop */
+static uint16_t JS_JogWord(int16_t speed)
+{
+    if (speed == 0) return 0u;
+    if (speed < 0) return (uint16_t)(0x8000u | ((uint16_t)(-speed) << 6) | 0x0001u);
+    return (uint16_t)(((uint16_t)speed << 6) | 0x0001u);
+}
+
+void JOYSTICK_Init(void)
+{
+    for (uint8_t a = 0u; a < JOYSTICK_AXES; a++) jsSpeed[a] = 0;
+
+    MBS_HoldRegisters[MBS_JS_FULL_SCALE] = JOYSTICK_FULL_SCALE_DEFAULT;
+    MBS_HoldRegisters[MBS_JS_DEADBAND]   = JOYSTICK_DEADBAND_DEFAULT;
+    MBS_HoldRegisters[MBS_JS_EXPO]       = JOYSTICK_EXPO_DEFAULT;
+    MBS_HoldRegisters[MBS_JS_RAMP_MS]    = JOYSTICK_RAMP_MS_DEFAULT;
+    MBS_HoldRegisters[MBS_JS_MAX_SPEED]  = JOYSTICK_SPEED_MAX;
+}
+
+void JOYSTICK_Task_1ms(void)
+{
+    JS_SETUP s;
+    int32_t step = 0;
+
+    /* Default R5 functionality: the master owns the speed index registers */
+    if ((MBS_HoldRegisters[MBS_JOYSTICK_SETUP] & MBS_JS_SLAVE_ENABLED) == 0u) {
+        for (uint8_t a = 0u; a < JOYSTICK_AXES; a++) jsSpeed[a] = 0;
+        MBS_InputRegisters[MBS_IR_JS_JOG_HORIZ] = 0u;
+        MBS_InputRegisters[MBS_IR_JS_JOG_VERT]  = 0u;
+        MBS_InputRegisters[MBS_IR_JS_FOCUS_SI]  = 0u;
+        return;
+    }
+
+    JS_ReadSetup(&s);
+    if (s.rampMs != 0u) {
+        step = (int32_t)(((uint32_t)s.maxSpeed << JS_RATE_SHIFT) / s.rampMs);
+        if (step == 0) step = 1;
+    }
+
+    for (uint8_t a = 0u; a < JOYSTICK_AXES; a++) {
+        const int32_t tgt = JS_Shape((int16_t)MBS_HoldRegisters[jsInputReg[a]], &s);
+
+        jsSpeed[a] = JS_Ramp(jsSpeed[a], tgt << JS_RATE_SHIFT, step);
+    }
+
+    MBS_HoldRegisters[MBS_HORIZ_R5_SI] = (uint16_t)JOYSTICK_GetSpeed(JOYSTICK_HORIZ);
+    MBS_HoldRegisters[MBS_VERT_R5_SI]  = (uint16_t)JOYSTICK_GetSpeed(JOYSTICK_VERT);
+    MBS_InputRegisters[MBS_IR_JS_JOG_HORIZ] = JS_JogWord(JOYSTICK_GetSpeed(JOYSTICK_HORIZ));
+    MBS_InputRegisters[MBS_IR_JS_JOG_VERT]  = JS_JogWord(JOYSTICK_GetSpeed(JOYSTICK_VERT));
+    MBS_InputRegisters[MBS_IR_JS_FOCUS_SI]  = (uint16_t)JOYSTICK_GetSpeed(JOYSTICK_FOCUS);
+}
+
+int16_t JOYSTICK_GetSpeed(JOYSTICK_AXIS axis)
+{
+    if (axis >= JOYSTICK_AXES) return 0;
+
+    /* Toward zero, a ramp never shows a speed it has not reached */
+    return (int16_t)(jsSpeed[axis] / (1 << JS_RATE_SHIFT));
+}
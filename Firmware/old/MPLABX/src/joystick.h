@@ -0,0 +1,53 @@
+#ifndef JOYSTICK_H
+#define JOYSTICK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* =========================================================================
+ * Joystick shaping to jog speeds
+ *
+ * Only with MBS_JS_SLAVE_ENABLED set in MBS_JOYSTICK_SETUP; otherwise
+ * the speeds are 0 and MBS_HORIZ_R5_SI / MBS_VERT_R5_SI are left to the
+ * master (default R5 functionality).
+ *
+ * Every 1 ms the joystick inputs MBS_HORIZ_INPUT, MBS_VERT_INPUT and
+ * MBS_FOCUS_INPUT (int16, +-MBS_JS_FULL_SCALE) are mapped to a signed
+ * speed 0..+-MBS_JS_MAX_SPEED:
+ *  - deadband: |input| <= MBS_JS_DEADBAND is 0, the rest is scaled to
+ *    the full range
+ *  - expo: MBS_JS_EXPO % of the curve is cubic, finer near the center
+ *  - rate limit: speeding up from 0 to full takes MBS_JS_RAMP_MS (0 =
+ *    off). Slowing down and stopping follow at once; the driver's own
+ *    deceleration (0x0099) applies there. A reversal stops first and
+ *    ramps up the other way.
+ *
+ * Speeds go to MBS_HORIZ_R5_SI / MBS_VERT_R5_SI and MBS_IR_JS_FOCUS_SI.
+ * The horizontal and vertical ones are also published as ready-to-send
+ * ADM jog command words (0x00CA: direction bit 15, 1 = reverse; speed
+ * bits 14..6; decelerate stop; run bit 0) in MBS_IR_JS_JOG_xxx.
+ * The factory values give the same mapping as the Node-RED jog flow.
+ * ========================================================================= */
+#define JOYSTICK_SPEED_MAX              511u    /* speed field of the jog word */
+#define JOYSTICK_FULL_SCALE_DEFAULT     100u
+#define JOYSTICK_DEADBAND_DEFAULT       5u
+#define JOYSTICK_EXPO_DEFAULT           0u
+#define JOYSTICK_RAMP_MS_DEFAULT        0u
+
+typedef enum {
+    JOYSTICK_HORIZ = 0,
+    JOYSTICK_VERT,
+    JOYSTICK_FOCUS,
+    JOYSTICK_AXES
+} JOYSTICK_AXIS;
+
+/** Speeds to 0, setup registers to the factory values. Call after MBS_InitModbus(). */
+void JOYSTICK_Init(void);
+
+/** Sample, shape and publish. Call from main loop at 1 ms cadence. */
+void JOYSTICK_Task_1ms(void);
+
+/** Signed speed of one axis as last published. */
+int16_t JOYSTICK_GetSpeed(JOYSTICK_AXIS axis);
+
+#endif /* JOYSTICK_H */
@@ -1,7 +1,7 @@
 /*
  * main.c ? stabil, ikke-blokkerende TLV493D-integrasjon
- *  - TLV_Task kjres hvert 50 ms
- *  - Data eksponeres til Modbus hvert 250 ms
+ *  - TLV_Task kjres hvert 10 ms (MCM: lesing startes fra 1 ms tick)
+ *  - TLV data eksponeres til Modbus hvert 10 ms
  *  - Eksisterende timer / Modbus / UART beholdt
  */
 
@@ -14,9 +14,33 @@
 #include "ModbusSlave.h"
 #include "tlv493d.h"   /* TLV493D driver */
 #include "endstop.h"
+#include "endstop_log.h"
+#include "endstop_cfg.h"
+#include "inputs.h"
+#include "portsnap.h"
+#include "adcscan.h"
+#include "inhibit.h"
+#include "pwrmon.h"
+#include "joystick.h"
+#include "diag.h"
+#include "supervisor.h"
+#include "fault.h"
+#include "nvstore.h"
+#include "tlv493d_cal.h"
+#include "tlv493d_fifo.h"
+#include "i2cbus.h"
+#include "irqplan.h"
 
 /* ===================== Konstanter ===================== */
-#define TLV_ADDR            0x1F
+/*
+ * TLV493D sensors on I2C1, TLV493D_ID order. Only the horizontal sensor is
+ * fitted today and it has no supply switch. The vertical / focus sensors
+ * (backplane BP-005/006) need one each, e.g.
+ *   { 0x5Au, TlvVertPower }, { TLV493D_ADDR_POWERUP, TlvFocusPower }
+ */
+static const TLV493D_Config_t tlvCfg[] = {
+    { TLV493D_ADDR_RESET, NULL },   /* horizontal */
+};
 
 /* ===================== Timer / Modbus ===================== */
 
@@ -35,6 +59,7 @@ TLV493D_Data_t mag;
 /* ===================== Prototyper ===================== */
 void UpdateTimers(void);
 void MBS_UART_Putch(uint8_t ch);
+void MBS_OnReadInputRegisters(uint16_t start, uint16_t count);
 
 
 /* ===================== CoreTimer callback ===================== */
@@ -43,6 +68,9 @@ void myCORETIMER(uint32_t status, uintptr_t context)
     (void)status; (void)context;
     TimerEvent1ms = true;
     myTime++;
+    TLV493D_Tick_1ms(myTime);
+    ENDSTOP_Tick_1ms();
+    PORTSNAP_Tick_1ms();
 }
 
 /* Callback function for the ModBus Slave driver */
@@ -51,6 +79,14 @@ void MBS_UART_Putch(uint8_t ch)
     UART1_Write(&ch, 1);
 }
 
+/* Function 4 read hook: input register blocks with read side effects */
+void MBS_OnReadInputRegisters(uint16_t start, uint16_t count)
+{
+    TLV493D_FifoOnRead(start, count);
+    ENDSTOP_LogOnRead(start, count);
+    PORTSNAP_OnRead(start, count);
+}
+
 
 /* ===================== Timere (URRT ? men med riktig nesting) ===================== */
 void UpdateTimers(void)
@@ -95,43 +131,215 @@ void UpdateTimers(void)
     }
 }
 
+/* ===================== TLV493D -> Modbus ===================== */
+static void PublishTLV(uint32_t now_ms)
+{
+    uint32_t tlvAgeMs = 0;
+    int16_t headingDeg = 0;
+    int16_t headingCdeg = 0;
+    int16_t tempC = 0;
+    bool tlvValid = TLV493D_GetLatest(TLV493D_HORIZ, &mag, now_ms, &tlvAgeMs);
+
+    MBS_HoldRegisters[MBS_TLV493D_X] = (uint16_t)mag.x;
+    MBS_HoldRegisters[MBS_TLV493D_Y] = (uint16_t)mag.y;
+    MBS_HoldRegisters[MBS_TLV493D_Z] = (uint16_t)mag.z;
+    MBS_HoldRegisters[MBS_TLV493D_TEMP] = (uint16_t)(int16_t)mag.temperature;
+    MBS_HoldRegisters[MBS_TLV493D_FRAME] = (uint16_t)mag.frame;
+    MBS_HoldRegisters[MBS_TLV493D_CH] = (uint16_t)mag.channel;
+    MBS_HoldRegisters[MBS_TLV493D_PWRDOWN] = (uint16_t)mag.powerDown;
+
+    (void)TLV493D_GetHeadingTemp(TLV493D_HORIZ, &headingDeg, &tempC, now_ms, NULL);
+    MBS_HoldRegisters[MBS_TLV493D_HEADING] = (uint16_t)(int16_t)headingDeg; /* [-180..180] */
+    MBS_HoldRegisters[MBS_TLV493D_TEMP_C] = (uint16_t)(int16_t)tempC; /* whole C */
+    (void)TLV493D_GetHeadingCdeg(TLV493D_HORIZ, &headingCdeg, now_ms, NULL);
+    MBS_HoldRegisters[MBS_TLV493D_HEADING_CDEG] = (uint16_t)headingCdeg;  /* 0.01 deg */
+
+    MBS_HoldRegisters[MBS_TLV493D_VALID] = (uint16_t)(tlvValid ? 1u : 0u);
+    MBS_HoldRegisters[MBS_TLV493D_AGE] = (uint16_t)((tlvAgeMs > 0xFFFFu) ? 0xFFFFu : tlvAgeMs); /* ms siden sist gyldig */
+
+    /* All sensors, input registers */
+    uint16_t fieldStatus = 0u;
+
+    for (uint8_t id = 0u; id < (uint8_t)TLV493D_MAX_SENSORS; id++) {
+        volatile uint16_t *r = &MBS_InputRegisters[MBS_IR_TLVS_BASE + id * MBS_IR_TLVS_STRIDE];
+        volatile uint16_t *rf = &MBS_InputRegisters[MBS_IR_TLVF_BASE + id * MBS_IR_TLVF_STRIDE];
+        uint16_t bmag = 0u;
+        uint8_t fieldFlags = 0u;
+
+        headingCdeg = 0;
+        tlvAgeMs = 0xFFFFFFFFu;
+        (void)TLV493D_GetHeadingCdeg(id, &headingCdeg, now_ms, &tlvAgeMs);
+        r[MBS_IR_TLVS_HEADING] = (uint16_t)headingCdeg;
+        r[MBS_IR_TLVS_AGE] = (uint16_t)((tlvAgeMs > 0xFFFFu) ? 0xFFFFu : tlvAgeMs);
+        r[MBS_IR_TLVS_ADDR] = TLV493D_GetAddress(id);
+
+        if (!TLV493D_GetField(id, &bmag, &fieldFlags)) {
+            bmag = 0u;
+            fieldFlags = 0u;
+        }
+        rf[MBS_IR_TLVF_BMAG] = bmag;
+        rf[MBS_IR_TLVF_FLAGS] = fieldFlags;
+        if (fieldFlags & TLV493D_FIELD_WEAK)      fieldStatus |= MBS_SL_STATUS_MAGNET_WEAK;
+        if (fieldFlags & TLV493D_FIELD_SATURATED) fieldStatus |= MBS_SL_STATUS_MAGNET_SATURATED;
+    }
+
+    MBS_RegClearBits(&MBS_HoldRegisters[MBS_SL_STATUS],
+                     (uint16_t)(MBS_SL_STATUS_MAGNET_WEAK | MBS_SL_STATUS_MAGNET_SATURATED));
+    MBS_RegSetBits(&MBS_HoldRegisters[MBS_SL_STATUS], fieldStatus);
+}
+
+/* Call once per second */
+static void PublishTLVStats(void)
+{
+    static uint32_t lastSamples = 0u;
+    TLV493D_Stats_t st;
+
+    TLV493D_GetStats(&st);
+    MBS_InputRegisters[MBS_IR_TLV_SAMPLES] = (uint16_t)st.samples;
+    MBS_InputRegisters[MBS_IR_TLV_STALE] = (uint16_t)st.stale;
+    MBS_InputRegisters[MBS_IR_TLV_ERRORS] = (uint16_t)st.errors;
+    MBS_InputRegisters[MBS_IR_TLV_OVERFLOWS] = (uint16_t)st.overflows;
+    MBS_InputRegisters[MBS_IR_TLV_RATE_HZ] = (uint16_t)(st.samples - lastSamples);
+    MBS_InputRegisters[MBS_IR_TLV_RESUMES] = (uint16_t)st.resumes;
+    MBS_InputRegisters[MBS_IR_TLV_REINITS] = (uint16_t)st.reinits;
+    MBS_InputRegisters[MBS_IR_TLV_RESUME_MS] = st.resumeMs;
+    MBS_InputRegisters[MBS_IR_TLV_RESUME_MAX_MS] = st.resumeMaxMs;
+    lastSamples = st.samples;
+}
+
+static uint8_t RegU8(uint16_t reg)
+{
+    uint16_t v = MBS_HoldRegisters[reg];
+    return (uint8_t)((v > 255u) ? 255u : v);
+}
+
+/* Filter settings from host, TLV493D_SetFilter() clamps to the valid ranges */
+static void ApplyTLVFilter(void)
+{
+    TLV493D_FilterSet_t f;
+
+    f.xyzt.median = RegU8(MBS_TLV493D_FILT_MEDIAN);
+    f.xyzt.decim = RegU8(MBS_TLV493D_FILT_DECIM);
+    f.xyzt.iirOrder = RegU8(MBS_TLV493D_FILT_IIR_ORDER);
+    f.xyzt.iirShift = RegU8(MBS_TLV493D_FILT_IIR_SHIFT);
+    f.headingShift = RegU8(MBS_TLV493D_HEADING_SHIFT);
+    f.headingHystCdeg = MBS_HoldRegisters[MBS_TLV493D_HEADING_HYST];
+    f.tempShift = RegU8(MBS_TLV493D_TEMP_SHIFT);
+    f.tempHystTenths = MBS_HoldRegisters[MBS_TLV493D_TEMP_HYST];
+    TLV493D_SetFilter(&f);
+}
+
+/* Field magnitude limits from host */
+static void ApplyTLVField(void)
+{
+    TLV493D_FieldCfg_t fc;
+
+    fc.bMin = MBS_HoldRegisters[MBS_TLV493D_BMIN];
+    fc.bMax = MBS_HoldRegisters[MBS_TLV493D_BMAX];
+    fc.tcPpm = (int16_t)MBS_HoldRegisters[MBS_TLV493D_BTC];
+    TLV493D_SetFieldCheck(&fc);
+}
+
+/* ===================== Deferred init (after the Modbus slave is live) ===================== */
+static void BootDeferredInit(void)
+{
+    /* TLV factory read + config are run by TLV493D_Task() from here on */
+    I2CBUS_Init();
+    TLV493D_FifoInit();
+    TLV493D_Init(tlvCfg, (uint8_t)(sizeof(tlvCfg) / sizeof(tlvCfg[0])));
+    TLV493D_CalInit();
+
+    MBS_HoldRegisters[MBS_OWN_ID_SW] =
+        10 + ((SW1_8_Get() << 3) |
+              (SW1_4_Get() << 2) |
+              (SW1_2_Get() << 1) |
+              (SW1_1_Get()));
+}
+
 /* ===================== main ===================== */
 int main(void)
 {
     uint8_t myModBusAddr;
     uint8_t RdBuffer[10];
-    int16_t headingDeg = 0;
-    int16_t tempC = 0;
     uint32_t cmdTimeOutTimer=0;
     uint8_t BlinkCnt = 0;
+    bool bootDeferredDone = false;
+    bool bootFirstRequest = false;
+
 
+    /* Boot profile: reset -> main() */
+    DIAG_BootMark(DIAG_BOOT_STARTUP);
 
-    /* Initialize all modules */
+    /* Reset cause / watchdog verdict from the previous run */
+    SUP_Init();
+    FAULT_Init();
+
+    /* Initialize all modules. Interrupts stay masked until they run at the
+     * levels of irqplan.h, not the MCC ones. */
+    IRQPLAN_Hold();
     SYS_Initialize(NULL);
+    IRQPLAN_Init();
+
+    /* ISR latency / run time statistics (input registers) */
+    DIAG_Init();
+
+    /* Calibration / configuration records in flash */
+    NVS_Init();
+    DIAG_BootMark(DIAG_BOOT_PERIPH);
 
     // Endstop inputs are configured by MCC (GPIO_Initialize) already.
-    // This driver uses the existing 1ms CoreTimer tick for edge-detection.
+    // This driver adds change notice interrupts on them, and logs every edge.
+    // Kept before the Modbus slave goes live so SL_STATUS is valid on first read.
+    ENDSTOP_LogInit();
     ENDSTOP_Init();
 
-    I2C1_CallbackRegister(TLV493D_I2C_Callback, 0);
-    TLV493D_Init(TLV_ADDR);
+    /* Debounced view of all port inputs, raw snapshots for the host */
+    INPUTS_Init();
+    PORTSNAP_Init();
+
+    /* Motor inhibit on X5 FA, supply drop watch on every ADC scan */
+    INHIBIT_Init();
+    PWRMON_Init();
+
+    /* Supply voltage: Timer1 + ADC + DMA, no CPU load */
+    ADCSCAN_Init();
 
     /* Set Modbus Slave Address */
     myModBusAddr = 10;
     MBS_InitModbus(myModBusAddr);
 
-    MBS_HoldRegisters[MBS_OWN_ID_SW] =
-        10 + ((SW1_8_Get() << 3) |
-              (SW1_4_Get() << 2) |
-              (SW1_2_Get() << 1) |
-              (SW1_1_Get()));
-
     MBS_HoldRegisters[MBS_SL_MODEL] = 6;            /* Searchlight Model */
     MBS_HoldRegisters[MBS_HD_ID] = (uint16_t)'-';   /* HW_ID */
     MBS_HoldRegisters[MBS_SW_ID] = 1;               /* SW_ID */
+    MBS_HoldRegisters[MBS_TLV493D_MODE] = TLV493D_MODE_MCM;
+    MBS_HoldRegisters[MBS_TLV493D_PERIOD] = TLV493D_PERIOD_DEFAULT_MS;
+    MBS_HoldRegisters[MBS_I2C_CLOCK_KHZ] = I2CBUS_CLOCK_DEFAULT_KHZ;
+    MBS_HoldRegisters[MBS_PORTSNAP_PERIOD_MS] = PORTSNAP_PERIOD_DEFAULT_MS;
+    MBS_HoldRegisters[MBS_TLV493D_FILT_MEDIAN] = 1u;
+    MBS_HoldRegisters[MBS_TLV493D_FILT_DECIM] = 1u;
+    MBS_HoldRegisters[MBS_TLV493D_FILT_IIR_ORDER] = 0u;
+    MBS_HoldRegisters[MBS_TLV493D_FILT_IIR_SHIFT] = 2u;
+    MBS_HoldRegisters[MBS_TLV493D_HEADING_SHIFT] = TLV493D_HEADING_SHIFT_DEFAULT;
+    MBS_HoldRegisters[MBS_TLV493D_HEADING_HYST] = TLV493D_HEADING_HYST_DEFAULT;
+    MBS_HoldRegisters[MBS_TLV493D_TEMP_SHIFT] = TLV493D_TEMP_SHIFT_DEFAULT;
+    MBS_HoldRegisters[MBS_TLV493D_TEMP_HYST] = TLV493D_TEMP_HYST_DEFAULT;
+    MBS_HoldRegisters[MBS_TLV493D_BMIN] = TLV493D_FIELD_BMIN_DEFAULT;
+    MBS_HoldRegisters[MBS_TLV493D_BMAX] = TLV493D_FIELD_BMAX_DEFAULT;
+    MBS_HoldRegisters[MBS_TLV493D_BTC] = (uint16_t)TLV493D_FIELD_TC_DEFAULT;
+    JOYSTICK_Init();
+
+    /* Endstop input table: stored one replaces the factory table */
+    ENDSTOP_CfgInit();
+
+    DIAG_BootMark(DIAG_BOOT_MODBUS);
 
     CORETIMER_CallbackSet(myCORETIMER, (uintptr_t)NULL);
     CORETIMER_Start();
+    ENDSTOP_Start();
+
+    /* Core timer count is running from here, arm deadlines + enable watchdog */
+    SUP_Start();
+    FAULT_Trace(FAULT_EV_BOOT, (uint16_t)SUP_GetResetCause());
 
     while (true) {
         SYS_Tasks();
@@ -140,12 +348,25 @@ int main(void)
             TimerEvent1ms = false;
             UpdateTimers();
             ENDSTOP_Task_1ms();
+            INPUTS_Task_1ms();
+            PORTSNAP_Task_1ms();
+            PWRMON_Task_1ms();
+            INHIBIT_Task_1ms();
+            JOYSTICK_Task_1ms();
+            SUP_CheckIn(SUP_TASK_TICK);
+        }
+
+        /* TLV state machine + sample drain hvert 10 ms */
+        if (TimerEvent10ms) {
+            TimerEvent10ms = false;
+            TLV493D_Task(myTime);
+            if (I2CBUS_Task(myTime)) SUP_CheckIn(SUP_TASK_I2C);
+            PublishTLV(myTime);
+            ADCSCAN_Task_10ms();
         }
 
-        /* TLV state machine hvert 50 ms */
         if (TimerEvent50ms) {
             TimerEvent50ms = false;
-            TLV493D_Task(myTime);
             
             if(cmdTimeOutTimer==0) {
                 if(Blink!=0x0A) {
@@ -171,6 +392,14 @@ int main(void)
         if (TimerEvent250ms) {
             TimerEvent250ms = false;
 
+            DIAG_Task_250ms();
+            SUP_Task_250ms();
+            FAULT_Task_250ms();
+            TLV493D_CalTask_250ms();
+            I2CBUS_Task_250ms();
+            ENDSTOP_CfgTask_250ms();
+            ENDSTOP_Task_250ms();
+
             // Status blink
             BlinkCnt++;
             BlinkCnt &= 0x07;
@@ -180,34 +409,30 @@ int main(void)
                 BLUE_LED_Clear();    
             }
                         
-            uint32_t tlvAgeMs = 0;
-            bool tlvValid = TLV493D_GetLatest(&mag, myTime, &tlvAgeMs);
-
-            MBS_HoldRegisters[MBS_TLV493D_X] = (uint16_t)mag.x;
-            MBS_HoldRegisters[MBS_TLV493D_Y] = (uint16_t)mag.y;
-            MBS_HoldRegisters[MBS_TLV493D_Z] = (uint16_t)mag.z;
-            MBS_HoldRegisters[MBS_TLV493D_TEMP] = (uint16_t)(int16_t)mag.temperature;
-            MBS_HoldRegisters[MBS_TLV493D_FRAME] = (uint16_t)mag.frame;
-            MBS_HoldRegisters[MBS_TLV493D_CH] = (uint16_t)mag.channel;
-            MBS_HoldRegisters[MBS_TLV493D_PWRDOWN] = (uint16_t)mag.powerDown;
-
-            (void)TLV493D_GetHeadingTemp(&headingDeg, &tempC, myTime, NULL);
-            MBS_HoldRegisters[MBS_TLV493D_HEADING] = (uint16_t)(int16_t)headingDeg; /* [-180..180] */
-            MBS_HoldRegisters[MBS_TLV493D_TEMP_C] = (uint16_t)(int16_t)tempC; /* whole C */
-
-            MBS_HoldRegisters[MBS_TLV493D_VALID] = (uint16_t)(tlvValid ? 1u : 0u);
-            MBS_HoldRegisters[MBS_TLV493D_AGE] = (uint16_t)tlvAgeMs; /* ms siden sist gyldig */
+            /* TLV acquisition mode / period from host */
+            uint16_t tlvPeriod = MBS_HoldRegisters[MBS_TLV493D_PERIOD];
+            TLV493D_SetAcquisition((MBS_HoldRegisters[MBS_TLV493D_MODE] != 0u) ? TLV493D_MODE_MCM : TLV493D_MODE_LOWPOWER,
+                                   (uint8_t)((tlvPeriod > 255u) ? 255u : tlvPeriod));
+            ApplyTLVFilter();
+            ApplyTLVField();
+            PORTSNAP_SetPeriod(MBS_HoldRegisters[MBS_PORTSNAP_PERIOD_MS]);
         }
 
         
         if (TimerEvent1s) {
             TimerEvent1s = false;
 
+            FAULT_Beat(FAULT_BEAT_SLOW, 0u);
+            PublishTLVStats();
+            DIAG_IsrProbe();
+            DIAG_StackScan();
+            SUP_CheckIn(SUP_TASK_SLOW);
+
             MBS_HoldRegisters[MBS_OWN_ID_SW] =
-            10 + ((SW1_8_Get() << 3) |
-                  (SW1_4_Get() << 2) |
-                  (SW1_2_Get() << 1) |
-                  (SW1_1_Get()));
+            10 + ((INPUTS_Get(SW1_8_PIN) << 3) |
+                  (INPUTS_Get(SW1_4_PIN) << 2) |
+                  (INPUTS_Get(SW1_2_PIN) << 1) |
+                  (INPUTS_Get(SW1_1_PIN)));
         
         } //..if (TimerEvent1s)
             
@@ -219,18 +444,22 @@ int main(void)
             Blink = 0xA;
         }
 
-        /* Process Modbus */
-        MBS_ProcessModbus();
+        /* Process Modbus; progress only when no frame hangs half received */
+        if (MBS_ProcessModbus()) SUP_CheckIn(SUP_TASK_MODBUS);
 
-        /* X5 FA output: holding register 62 controls PIC pin 41 / RC14. */
-        if (MBS_HoldRegisters[MBS_X5_FA] != 0u) {
-            LATCSET = (1u << 14);
-        } else {
-            LATCCLR = (1u << 14);
+        /* Non-critical init once the slave has been serviced the first time */
+        if (!bootDeferredDone) {
+            BootDeferredInit();
+            bootDeferredDone = true;
+            DIAG_BootMark(DIAG_BOOT_DEFERRED);
+        }
+        if (!bootFirstRequest && (MBS_RequestCounter != 0u)) {
+            bootFirstRequest = true;
+            DIAG_BootMark(DIAG_BOOT_FIRST_REQUEST);
         }
 
-        /* Guard the Watchdog */
-        WDTCONbits.WDTCLRKEY = 0x5743;
+        /* Guard the Watchdog - only cleared while all tasks meet their deadlines */
+        SUP_Service();
     }
 
     return (EXIT_FAILURE);
@@ -0,0 +1,213 @@
+#include <string.h>
+#include "definitions.h"
+#include "ModbusSlave.h"
+#include "supervisor.h"
+#include "nvstore.h"
+
+/* ===================== Constants ===================== */
+#define NVS_PAGE_SIZE       2048u
+#define NVS_FLASH_BASE      0x9D03F000u     /* last two pages of kseg0_program_mem */
+#define NVS_FLASH_KSEG1     0xBD03F000u     /* same, uncached read */
+#define NVS_PHYS(a)         ((a) & 0x1FFFFFFFu)
+#define NVS_MAGIC           0x4E565331u     /* "NVS1" */
+
+#define NVS_OP_DWORD_PROGRAM    0x2u
+#define NVS_OP_PAGE_ERASE       0x4u
+
+/* Max record size per slot (bytes, multiple of 4) */
+#define NVS_SLOT_TLV_CAL    32u
+#define NVS_SLOT_INPUTS     64u
+#define NVS_SLOT_INHIBIT    16u
+
+static const uint16_t nvsSlotMax[NVS_ID_COUNT] = {
+    [NVS_ID_TLV_CAL] = NVS_SLOT_TLV_CAL,
+    [NVS_ID_INPUTS]  = NVS_SLOT_INPUTS,
+    [NVS_ID_INHIBIT] = NVS_SLOT_INHIBIT,
+};
+
+/* ===================== Image layout ===================== */
+typedef struct {
+    uint32_t magic;
+    uint32_t seq;           /* newest image wins */
+    uint16_t size;          /* bytes after the header */
+    uint16_t crc;           /* MBS_CRC16 over the bytes after the header */
+    uint32_t rsv;
+} NVS_HDR;
+
+typedef struct {
+    uint16_t len;           /* 0 = never written */
+    uint16_t crc;
+} NVS_SLOT;
+
+#define NVS_SLOTS_SIZE      (NVS_ID_COUNT * sizeof(NVS_SLOT) + NVS_SLOT_TLV_CAL + NVS_SLOT_INPUTS + NVS_SLOT_INHIBIT)
+#define NVS_IMAGE_SIZE      ((sizeof(NVS_HDR) + NVS_SLOTS_SIZE + 7u) & ~7u)
+
+/* RAM copy of the current image, programmed in double words */
+static uint32_t nvsImage[NVS_IMAGE_SIZE / 4u] __attribute__((aligned(8)));
+static uint8_t  nvsPage = 0u;               /* page holding nvsImage */
+
+/* Keeps the linker away from the two pages */
+static const uint8_t nvsFlash[2u * NVS_PAGE_SIZE]
+    __attribute__((space(prog), address(NVS_FLASH_BASE), noload, used));
+
+static NVS_HDR *NVS_Hdr(void)
+{
+    return (NVS_HDR *)nvsImage;
+}
+
+static uint8_t *NVS_SlotPtr(NVS_ID id)
+{
+    uint8_t *p = (uint8_t *)nvsImage + sizeof(NVS_HDR);
+
+    for (unsigned i = 0u; i < (unsigned)id; i++) p += sizeof(NVS_SLOT) + nvsSlotMax[i];
+    return p;
+}
+
+static uint16_t NVS_Crc(const uint8_t *p, uint32_t n)
+{
+    uint32_t crc = 0xFFFFu;
+
+    while (n-- > 0u) MBS_CRC16(*p++, &crc);
+    return (uint16_t)crc;
+}
+
+static const uint8_t *NVS_PageAddr(uint8_t page)
+{
+    return (const uint8_t *)(uintptr_t)(NVS_FLASH_KSEG1 + (uint32_t)page * NVS_PAGE_SIZE);
+}
+
+/* A smaller image is one from older firmware with fewer slots */
+static bool NVS_PageValid(uint8_t page, uint32_t *seq, uint16_t *size)
+{
+    const uint8_t *p = NVS_PageAddr(page);
+    NVS_HDR h;
+
+    memcpy(&h, p, sizeof(h));
+    if (h.magic != NVS_MAGIC || h.size == 0u || h.size > (NVS_IMAGE_SIZE - sizeof(NVS_HDR))) return false;
+    if (NVS_Crc(p + sizeof(NVS_HDR), h.size) != h.crc) return false;
+
+    *seq = h.seq;
+    *size = h.size;
+    return true;
+}
+
+/*
+ * The flash stalls the CPU; the plib core timer handler only adds one
+ * period to COMPARE, which is then behind COUNT and would not match again
+ * until the count wraps (~358 s). Also give every task a fresh deadline.
+ */
+static void NVS_AfterStall(void)
+{
+    bool irq = EVIC_INT_Disable();
+    uint32_t count = _CP0_GET_COUNT();
+
+    if ((int32_t)(_CP0_GET_COMPARE() - count) < 50) {
+        _CP0_SET_COMPARE(count + 50u);
+    }
+    EVIC_INT_Restore(irq);
+
+    SUP_Rearm();
+}
+
+static bool NVS_Op(uint32_t op, uint32_t addr)
+{
+    bool irq;
+
+    NVMCONCLR = _NVMCON_NVMOP_MASK;
+    NVMCONSET = op;
+    NVMADDR = NVS_PHYS(addr);
+    NVMCONSET = _NVMCON_WREN_MASK;
+
+    irq = EVIC_INT_Disable();
+    NVMKEY = 0x00000000u;
+    NVMKEY = 0xAA996655u;
+    NVMKEY = 0x556699AAu;
+    NVMCONSET = _NVMCON_WR_MASK;
+    EVIC_INT_Restore(irq);
+
+    while ((NVMCON & _NVMCON_WR_MASK) != 0u) {
+    }
+    NVMCONCLR = _NVMCON_WREN_MASK;
+
+    return (NVMCON & (_NVMCON_WRERR_MASK | _NVMCON_LVDERR_MASK)) == 0u;
+}
+
+/* ===================== Public API ===================== */
+void NVS_Init(void)
+{
+    uint32_t seq0 = 0u, seq1 = 0u;
+    uint16_t size0 = 0u, size1 = 0u;
+    bool ok0 = NVS_PageValid(0u, &seq0, &size0);
+    bool ok1 = NVS_PageValid(1u, &seq1, &size1);
+
+    memset(nvsImage, 0, sizeof(nvsImage));
+
+    if (ok0 || ok1) {
+        nvsPage = (ok1 && (!ok0 || (int32_t)(seq1 - seq0) > 0)) ? 1u : 0u;
+        memcpy(nvsImage, NVS_PageAddr(nvsPage), sizeof(NVS_HDR) + (nvsPage ? size1 : size0));
+        /* Older layout: the slots added since are zero = never written */
+        NVS_Hdr()->size = (uint16_t)(NVS_IMAGE_SIZE - sizeof(NVS_HDR));
+        return;
+    }
+
+    /* Nothing stored yet: empty image, first write goes to page 0 */
+    NVS_Hdr()->magic = NVS_MAGIC;
+    NVS_Hdr()->size = (uint16_t)(NVS_IMAGE_SIZE - sizeof(NVS_HDR));
+    nvsPage = 1u;
+}
+
+bool NVS_Read(NVS_ID id, void *dst, uint16_t len)
+{
+    const uint8_t *p = NVS_SlotPtr(id);
+    NVS_SLOT slot;
+
+    memcpy(&slot, p, sizeof(slot));
+    if (slot.len == 0u || slot.len != len) return false;
+    if (NVS_Crc(p + sizeof(NVS_SLOT), len) != slot.crc) return false;
+
+    memcpy(dst, p + sizeof(NVS_SLOT), len);
+    return true;
+}
+
+bool NVS_Stage(NVS_ID id, const void *src, uint16_t len)
+{
+    uint8_t *p = NVS_SlotPtr(id);
+    NVS_SLOT slot;
+
+    if (len == 0u || len > nvsSlotMax[id]) return false;
+
+    slot.len = len;
+    slot.crc = NVS_Crc((const uint8_t *)src, len);
+    memcpy(p, &slot, sizeof(slot));
+    memset(p + sizeof(NVS_SLOT), 0, nvsSlotMax[id]);
+    memcpy(p + sizeof(NVS_SLOT), src, len);
+    return true;
+}
+
+bool NVS_Commit(void)
+{
+    uint8_t page = (uint8_t)(nvsPage ^ 1u);
+    uint32_t addr = NVS_FLASH_BASE + (uint32_t)page * NVS_PAGE_SIZE;
+    bool ok;
+
+    NVS_Hdr()->seq++;
+    NVS_Hdr()->crc = NVS_Crc((const uint8_t *)nvsImage + sizeof(NVS_HDR), NVS_Hdr()->size);
+
+    ok = NVS_Op(NVS_OP_PAGE_ERASE, addr);
+    for (uint32_t i = 0u; ok && i < NVS_IMAGE_SIZE / 4u; i += 2u) {
+        NVMDATA0 = nvsImage[i];
+        NVMDATA1 = nvsImage[i + 1u];
+        ok = NVS_Op(NVS_OP_DWORD_PROGRAM, addr + i * 4u);
+    }
+    NVS_AfterStall();
+
+    if (ok && memcmp(NVS_PageAddr(page), nvsImage, NVS_IMAGE_SIZE) != 0) ok = false;
+    if (ok) nvsPage = page;
+
+    return ok;
+}
+
+bool NVS_Write(NVS_ID id, const void *src, uint16_t len)
+{
+    return NVS_Stage(id, src, len) && NVS_Commit();
+}
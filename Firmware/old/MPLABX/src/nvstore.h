@@ -0,0 +1,50 @@
+#ifndef NVSTORE_H
+#define NVSTORE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* =========================================================================
+ * Non-volatile record store in program flash
+ *
+ * The last two 2 KB flash pages hold alternating copies of one small
+ * image (header with sequence number + CRC, then one fixed slot per
+ * record). NVS_Write() updates the RAM copy and programs it into the
+ * older page, so a reset during the write leaves the previous image.
+ * New records are only ever added at the end: an image written by older
+ * firmware is loaded as it is, the new slots read as never written.
+ *
+ * Page erase stalls the CPU (interrupts included) for up to ~20 ms.
+ * Only write on a host command, never from the periodic tasks. The core
+ * timer compare and the task supervisor are re-armed after the write.
+ * The pages are not part of the hex image (noload), a reflash keeps them.
+ * ========================================================================= */
+typedef enum {
+    NVS_ID_TLV_CAL = 0,     /* tlv493d_cal.c, TLV493D_Cal_t[TLV493D_MAX_SENSORS] */
+    NVS_ID_INPUTS,          /* endstop_cfg.c, ENDSTOP_Config_t */
+    NVS_ID_INHIBIT,         /* endstop_cfg.c, uint16_t[INHIBIT_RULES] */
+    NVS_ID_COUNT
+} NVS_ID;
+
+/** Load the newest valid image. Call once at boot, before any NVS_Read(). */
+void NVS_Init(void);
+
+/** Copy a record. False if it was never written or its size differs. */
+bool NVS_Read(NVS_ID id, void *dst, uint16_t len);
+
+/**
+ * Store a record (blocking, see above). False on flash error or verify
+ * failure; the record is then only kept in RAM until the next reset.
+ */
+bool NVS_Write(NVS_ID id, const void *src, uint16_t len);
+
+/**
+ * Records that belong together: NVS_Stage() each one into the RAM copy,
+ * then one NVS_Commit() programs them in a single page write, so either
+ * all or none of them are in flash after a reset. Stage fails only on a
+ * bad size, Commit as NVS_Write().
+ */
+bool NVS_Stage(NVS_ID id, const void *src, uint16_t len);
+bool NVS_Commit(void);
+
+#endif /* NVSTORE_H */
@@ -0,0 +1,121 @@
+#include <string.h>
+#include "definitions.h"
+#include "ModbusSlave.h"
+#include "endstop.h"
+#include "portsnap.h"
+
+#define SNAP_IR_END     (MBS_IR_PSNAP_ENTRY + PORTSNAP_HISTORY * MBS_IR_PSNAP_STRIDE)
+
+typedef struct {
+    uint32_t us;            /* ENDSTOP_NowUs() */
+    uint16_t port[4];       /* PORTA..PORTD */
+    uint16_t seq;
+} SNAP_ENTRY;
+
+/* Producer: core timer ISR. Consumer: main loop with interrupts disabled. */
+static SNAP_ENTRY snapBuf[PORTSNAP_HISTORY];
+static volatile uint16_t snapHead = 0u;     /* next write */
+static volatile uint16_t snapFill = 0u;     /* valid entries */
+static volatile uint16_t snapSeq = 0u;      /* sequence number of the next snapshot */
+static volatile uint16_t snapPeriod = PORTSNAP_PERIOD_DEFAULT_MS;
+static uint16_t snapCnt = 0u;               /* ISR only */
+static uint16_t snapPublished = 0u;         /* seq + 1 of the one in MBS_PORTx, 0 = none */
+
+void PORTSNAP_Init(void)
+{
+    bool irq = EVIC_INT_Disable();
+
+    snapHead = 0u;
+    snapFill = 0u;
+    snapSeq = 0u;
+    snapCnt = 0u;
+    snapPublished = 0u;
+    EVIC_INT_Restore(irq);
+}
+
+void PORTSNAP_SetPeriod(uint16_t ms)
+{
+    if (ms == snapPeriod) return;
+
+    bool irq = EVIC_INT_Disable();
+    snapPeriod = ms;
+    snapCnt = 0u;
+    EVIC_INT_Restore(irq);
+}
+
+void PORTSNAP_Tick_1ms(void)
+{
+    if (snapPeriod == 0u || ++snapCnt < snapPeriod) return;
+    snapCnt = 0u;
+
+    SNAP_ENTRY *e = &snapBuf[snapHead];
+    bool irq = EVIC_INT_Disable();
+
+    /* Four back to back reads, nothing can run in between */
+    e->port[0] = (uint16_t)PORTA;
+    e->port[1] = (uint16_t)PORTB;
+    e->port[2] = (uint16_t)PORTC;
+    e->port[3] = (uint16_t)PORTD;
+    e->us = ENDSTOP_NowUs();
+    e->seq = snapSeq++;
+
+    snapHead = (uint16_t)((snapHead + 1u) & (PORTSNAP_HISTORY - 1u));
+    if (snapFill < PORTSNAP_HISTORY) snapFill++;
+    EVIC_INT_Restore(irq);
+}
+
+/* Newest first, returns the number copied */
+static uint16_t SNAP_Copy(SNAP_ENTRY *dst)
+{
+    bool irq = EVIC_INT_Disable();
+    uint16_t n = snapFill;
+
+    for (uint16_t i = 0u; i < n; i++) {
+        dst[i] = snapBuf[(snapHead - 1u - i) & (PORTSNAP_HISTORY - 1u)];
+    }
+    EVIC_INT_Restore(irq);
+    return n;
+}
+
+void PORTSNAP_Task_1ms(void)
+{
+    SNAP_ENTRY e;
+    bool irq = EVIC_INT_Disable();
+
+    if (snapFill == 0u || snapPublished == snapSeq) {
+        EVIC_INT_Restore(irq);
+        return;
+    }
+    e = snapBuf[(snapHead - 1u) & (PORTSNAP_HISTORY - 1u)];
+    snapPublished = snapSeq;
+    EVIC_INT_Restore(irq);
+
+    MBS_HoldRegisters[MBS_PORTA] = e.port[0];
+    MBS_HoldRegisters[MBS_PORTB] = e.port[1];
+    MBS_HoldRegisters[MBS_PORTC] = e.port[2];
+    MBS_HoldRegisters[MBS_PORTD] = e.port[3];
+}
+
+void PORTSNAP_OnRead(uint16_t start, uint16_t count)
+{
+    if (start >= SNAP_IR_END || (uint32_t)start + count <= MBS_IR_PSNAP_BASE) return;
+
+    SNAP_ENTRY e[PORTSNAP_HISTORY];
+    uint16_t n = SNAP_Copy(e);
+
+    for (uint16_t i = 0u; i < PORTSNAP_HISTORY; i++) {
+        volatile uint16_t *r = &MBS_InputRegisters[MBS_IR_PSNAP_ENTRY + i * MBS_IR_PSNAP_STRIDE];
+
+        if (i >= n) memset(&e[i], 0, sizeof(e[i]));
+        r[MBS_IR_PSNAP_SEQ]      = e[i].seq;
+        r[MBS_IR_PSNAP_T_US_HI]  = (uint16_t)(e[i].us >> 16);
+        r[MBS_IR_PSNAP_T_US_LO]  = (uint16_t)e[i].us;
+        r[MBS_IR_PSNAP_PORTA]    = e[i].port[0];
+        r[MBS_IR_PSNAP_PORTB]    = e[i].port[1];
+        r[MBS_IR_PSNAP_PORTC]    = e[i].port[2];
+        r[MBS_IR_PSNAP_PORTD]    = e[i].port[3];
+    }
+
+    MBS_InputRegisters[MBS_IR_PSNAP_COUNT]     = n;
+    MBS_InputRegisters[MBS_IR_PSNAP_PERIOD_MS] = snapPeriod;
+}
@@ -0,0 +1,38 @@
+#ifndef PORTSNAP_H
+#define PORTSNAP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* =========================================================================
+ * GPIO port snapshots for field diagnostics
+ *
+ * Every PORTSNAP period the 1 ms core timer tick reads PORTA..PORTD
+ * back to back with interrupts disabled, so the four words belong to
+ * the same instant. Each snapshot gets a 16-bit sequence number and
+ * a timestamp on the endstop clock (ENDSTOP_NowUs()), so it lines up
+ * with the endstop event log.
+ *
+ * The newest one is copied to MBS_PORTA..MBS_PORTD. The last
+ * PORTSNAP_HISTORY are kept in a ring, and a function 4 read of the
+ * MBS_IR_PSNAP_xxx block returns them newest first. The read has no
+ * side effect; gaps in SEQ show how many were overwritten in between.
+ * ========================================================================= */
+#define PORTSNAP_HISTORY            8u      /* power of two */
+#define PORTSNAP_PERIOD_DEFAULT_MS  10u
+
+void PORTSNAP_Init(void);
+
+/** Period in ms, 0 = off. Main loop. */
+void PORTSNAP_SetPeriod(uint16_t ms);
+
+/** Call from the 1 ms core timer interrupt. */
+void PORTSNAP_Tick_1ms(void);
+
+/** Copy the newest snapshot to MBS_PORTA..MBS_PORTD. Main loop, 1 ms. */
+void PORTSNAP_Task_1ms(void);
+
+/** Call from MBS_OnReadInputRegisters(). Main loop context. */
+void PORTSNAP_OnRead(uint16_t start, uint16_t count);
+
+#endif /* PORTSNAP_H */
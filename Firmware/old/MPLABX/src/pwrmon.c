@@ -0,0 +1,108 @@
+#include "definitions.h"
+#include "ModbusSlave.h"
+#include "adcscan.h"
+#include "endstop.h"
+#include "fault.h"
+#include "inhibit.h"
+#include "pwrmon.h"
+
+/* Thresholds in 12-bit counts, set by the main loop, read in the DMA0 ISR */
+static volatile uint16_t pwrLimitMv = 0u;
+static volatile uint16_t pwrDropCnt = 0u;       /* 0 = off */
+static volatile uint16_t pwrBackCnt = 0u;
+
+/* Event state, DMA0 ISR; main loop copies it with interrupts disabled */
+static bool     pwrLow = false;
+static uint8_t  pwrRun = 0u;
+static uint16_t pwrMin = 0u;                    /* counts, this event */
+static uint32_t pwrT0 = 0u;                     /* us, ENDSTOP_NowUs() */
+static uint32_t pwrT1 = 0u;
+static volatile uint16_t pwrEvents = 0u;
+
+static uint16_t pwrTraced = 0u;                 /* main loop */
+
+void PWRMON_Init(void)
+{
+    bool irq = EVIC_INT_Disable();
+
+    pwrLow = false;
+    pwrRun = 0u;
+    pwrEvents = 0u;
+    pwrTraced = 0u;
+    EVIC_INT_Restore(irq);
+}
+
+void ADCSCAN_OnScan(const uint16_t *v)
+{
+    const uint16_t c = v[ADCSCAN_POWER_IN];
+
+    if (pwrDropCnt == 0u) return;
+
+    if (!pwrLow) {
+        pwrRun = (c < pwrDropCnt) ? (uint8_t)(pwrRun + 1u) : 0u;
+        if (pwrRun < PWRMON_DROP_SCANS) return;
+
+        INHIBIT_Set(INHIBIT_SRC_SUPPLY, true);
+        pwrLow = true;
+        pwrMin = c;
+        pwrT0 = ENDSTOP_NowUs();
+        pwrT1 = pwrT0;
+        pwrEvents++;
+        return;
+    }
+
+    if (c < pwrMin) pwrMin = c;
+    if (c >= pwrBackCnt) {
+        pwrLow = false;
+        pwrRun = 0u;
+        pwrT1 = ENDSTOP_NowUs();
+        INHIBIT_Set(INHIBIT_SRC_SUPPLY, false);
+    }
+}
+
+void PWRMON_Task_1ms(void)
+{
+    const uint16_t limit = MBS_HoldRegisters[MBS_PWR_DROP_LIMIT];
+    uint16_t events, minCnt, minMv;
+    uint32_t t0, dur;
+    bool low, irq;
+
+    if (limit != pwrLimitMv) {
+        uint16_t drop = (limit == 0u) ? 0u : ADCSCAN_SupplyMvToCounts(limit);
+        uint16_t back = ADCSCAN_SupplyMvToCounts((uint16_t)((limit > 0xFFFFu - PWRMON_HYST_MV) ? 0xFFFFu : limit + PWRMON_HYST_MV));
+
+        irq = EVIC_INT_Disable();
+        pwrLimitMv = limit;
+        pwrDropCnt = (drop == 0u && limit != 0u) ? 1u : drop;
+        pwrBackCnt = back;
+        if (limit == 0u && pwrLow) {
+            pwrLow = false;
+            INHIBIT_Set(INHIBIT_SRC_SUPPLY, false);
+        }
+        EVIC_INT_Restore(irq);
+    }
+
+    irq = EVIC_INT_Disable();
+    low = pwrLow;
+    events = pwrEvents;
+    minCnt = pwrMin;
+    t0 = pwrT0;
+    dur = (low ? ENDSTOP_NowUs() : pwrT1) - pwrT0;
+    EVIC_INT_Restore(irq);
+
+    minMv = (events != 0u) ? ADCSCAN_ToSupplyMv((uint16_t)(minCnt * 4u)) : 0u;
+
+    /* Persistent copy while it lasts: the drop may end in a brown-out reset */
+    if (events != pwrTraced || low) {
+        if (events != pwrTraced) FAULT_Trace(FAULT_EV_SUPPLY_DROP, limit);
+        FAULT_SupplyDrop((uint16_t)(events - pwrTraced), minMv);
+        pwrTraced = events;
+    }
+
+    MBS_InputRegisters[MBS_IR_PWR_EVENTS]   = events;
+    MBS_InputRegisters[MBS_IR_PWR_LOW]      = low ? 1u : 0u;
+    MBS_InputRegisters[MBS_IR_PWR_T_US_HI]  = (uint16_t)(t0 >> 16);
+    MBS_InputRegisters[MBS_IR_PWR_T_US_LO]  = (uint16_t)t0;
+    MBS_InputRegisters[MBS_IR_PWR_MIN_MV]   = minMv;
+    MBS_InputRegisters[MBS_IR_PWR_DURATION_MS] = (uint16_t)(((dur / 1000u) > 0xFFFFu) ? 0xFFFFu : (dur / 1000u));
+}
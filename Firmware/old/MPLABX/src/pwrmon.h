@@ -0,0 +1,32 @@
+#ifndef PWRMON_H
+#define PWRMON_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* =========================================================================
+ * Supply drop watch
+ *
+ * Every ADC scan (ADCSCAN_OnScan(), DMA0 interrupt, 500 us) compares
+ * one AN7 sample with MBS_PWR_DROP_LIMIT. PWRMON_DROP_SCANS samples in
+ * a row below it, so at most ~1 ms after the drop, make a supply drop
+ * event. The event raises the motor inhibit (INHIBIT_SRC_SUPPLY, which
+ * also sets MBS_SL_STATUS_ALARM) and records the time. The supply is
+ * back once it is PWRMON_HYST_MV above the limit; the lowest value and
+ * the duration complete the record.
+ *
+ * The last event is published in MBS_IR_PWR_xxx and added to the fault
+ * trace (FAULT_EV_SUPPLY_DROP). Count, time and lowest value also go to
+ * the persistent fault record while the drop lasts (FAULT_SupplyDrop(),
+ * MBS_IR_FAULT_DROP_xxx), so a brown-out reset that follows still shows
+ * it. A drop deep enough for a power-on reset loses it.
+ * ========================================================================= */
+#define PWRMON_DROP_SCANS   2u      /* consecutive samples below the limit */
+#define PWRMON_HYST_MV      500u
+
+void PWRMON_Init(void);
+
+/** Limit from MBS_PWR_DROP_LIMIT (mV, 0 = off), fault trace, publish. Call at 1 ms cadence. */
+void PWRMON_Task_1ms(void);
+
+#endif /* PWRMON_H */
@@ -0,0 +1,68 @@
+#include "seqring.h"
+
+static uint16_t RING_Wrap(const SEQRING *r, uint16_t i)
+{
+    return (uint16_t)(i & (2u * r->len - 1u));
+}
+
+void SEQRING_Reset(SEQRING *r)
+{
+    r->head = 0u;
+    r->tail = 0u;
+    r->seq = 0u;
+    r->overflows = 0u;
+}
+
+uint16_t SEQRING_Level(const SEQRING *r)
+{
+    return RING_Wrap(r, (uint16_t)(r->head - r->tail));
+}
+
+bool SEQRING_Claim(SEQRING *r, uint16_t *slot)
+{
+    if (SEQRING_Level(r) >= r->len) {
+        /* Drop the newest; the sequence number still counts it */
+        r->overflows++;
+        r->seq++;
+        return false;
+    }
+
+    *slot = (uint16_t)(r->head & (r->len - 1u));
+    return true;
+}
+
+void SEQRING_Push(SEQRING *r)
+{
+    r->slotSeq[r->head & (r->len - 1u)] = r->seq++;
+    r->head = RING_Wrap(r, (uint16_t)(r->head + 1u));
+}
+
+void SEQRING_Read(SEQRING *r, volatile uint16_t *ir, uint16_t count,
+                  uint16_t entries, uint16_t stride, SEQRING_PUT put)
+{
+    if (count < SEQRING_IR_ENTRY) return;
+
+    uint16_t room = (uint16_t)((count - SEQRING_IR_ENTRY) / stride);
+    uint16_t level = SEQRING_Level(r);
+    uint16_t first = r->seq;
+    uint16_t n = 0u;
+
+    if (room > entries) room = entries;
+    if (level > 0u) first = r->slotSeq[r->tail & (r->len - 1u)];
+
+    /* One read is gap free: stop at a drop, the next read shows it in SEQ */
+    while (n < room && n < level) {
+        const uint16_t slot = (uint16_t)(r->tail & (r->len - 1u));
+
+        if (r->slotSeq[slot] != (uint16_t)(first + n)) break;
+
+        put(slot, &ir[SEQRING_IR_ENTRY + n * stride]);
+        r->tail = RING_Wrap(r, (uint16_t)(r->tail + 1u));
+        n++;
+    }
+
+    ir[SEQRING_IR_FILL]      = SEQRING_Level(r);
+    ir[SEQRING_IR_OVERFLOWS] = (uint16_t)r->overflows;
+    ir[SEQRING_IR_COUNT]     = n;
+    ir[SEQRING_IR_SEQ]       = first;
+}
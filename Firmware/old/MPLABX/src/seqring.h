@@ -0,0 +1,61 @@
+#ifndef SEQRING_H
+#define SEQRING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* =========================================================================
+ * Sequence-numbered ring for destructive host reads
+ *
+ * Shared by the TLV493D sample FIFO and the endstop log. The entries live
+ * in the owner's array; the ring keeps the indices and the sequence number
+ * of every slot. One producer (main loop or ISR), one consumer (main loop).
+ *
+ * When full, new entries are dropped and counted, and still use up a
+ * sequence number. SEQRING_Read() pops into input registers laid out as
+ *   +0 FILL  +1 OVERFLOWS  +2 COUNT  +3 SEQ  then the entries
+ * and only returns consecutive entries, so the host finds every gap from
+ * SEQ of the next read.
+ * ========================================================================= */
+#define SEQRING_IR_FILL         0u      /* entries left after this read */
+#define SEQRING_IR_OVERFLOWS    1u      /* entries dropped, ring full */
+#define SEQRING_IR_COUNT        2u      /* entries in this read */
+#define SEQRING_IR_SEQ          3u      /* sequence number of the first entry */
+#define SEQRING_IR_ENTRY        4u
+
+typedef struct {
+    uint16_t *slotSeq;                  /* len entries */
+    uint16_t len;                       /* power of two */
+    volatile uint16_t head;             /* next write, modulo 2 * len */
+    volatile uint16_t tail;             /* next read */
+    volatile uint16_t seq;              /* sequence number of the next entry */
+    volatile uint32_t overflows;
+} SEQRING;
+
+/* Static definition over a uint16_t slotSeq[len] array */
+#define SEQRING_DEFINE(name, slotSeqArr) \
+    SEQRING name = { (slotSeqArr), (uint16_t)(sizeof(slotSeqArr) / sizeof((slotSeqArr)[0])), 0u, 0u, 0u, 0u }
+
+/** Copies the entry in 'slot' to 'reg' (one entry stride). */
+typedef void (*SEQRING_PUT)(uint16_t slot, volatile uint16_t *reg);
+
+/** Empty, sequence numbers from 0. Not concurrent with the producer. */
+void SEQRING_Reset(SEQRING *r);
+
+uint16_t SEQRING_Level(const SEQRING *r);
+
+/**
+ * Producer: slot for a new entry. False when full; the entry is then
+ * dropped and counted. Fill the slot, then SEQRING_Push().
+ */
+bool SEQRING_Claim(SEQRING *r, uint16_t *slot);
+void SEQRING_Push(SEQRING *r);
+
+/**
+ * Consumer: a host read of 'count' registers at 'ir'. Pops up to
+ * 'entries' entries of 'stride' registers through put().
+ */
+void SEQRING_Read(SEQRING *r, volatile uint16_t *ir, uint16_t count,
+                  uint16_t entries, uint16_t stride, SEQRING_PUT put);
+
+#endif /* SEQRING_H */
@@ -0,0 +1,159 @@
+#include "definitions.h"
+#include "ModbusSlave.h"
+#include "supervisor.h"
+#include "fault.h"
+
+/* ===================== Constants ===================== */
+#define SUP_TICKS_PER_MS        (CORE_TIMER_FREQUENCY / 1000u)
+#define SUP_PERSIST_MAGIC       0x53555056u     /* "SUPV" */
+#define SUP_WDT_CLEAR_KEY       0x5743u
+
+/* Deadline per task [ms]. The watchdog period (RWDTPS) adds ~128 ms. */
+static const uint16_t supDeadlineMs[SUP_TASK_COUNT] = {
+    [SUP_TASK_TICK]   = 20u,
+    [SUP_TASK_I2C]    = 1000u,      /* >> I2CBUS_XFER_TIMEOUT_MS, queue progress */
+    [SUP_TASK_MODBUS] = 1000u,      /* > longest frame at 9600 baud + MBS_TIMEOUT */
+    [SUP_TASK_SLOW]   = 3000u,
+};
+
+/* ===================== Persistent record (survives reset, not POR) ===================== */
+typedef struct {
+    uint32_t magic;
+    uint32_t bootCount;
+    uint32_t wdtCount;
+    uint8_t  verdictTask;       /* task that missed its deadline, SUP_TASK_NONE */
+    uint8_t  lastCheckIn;       /* last task that reported progress */
+    uint16_t ageMs;             /* verdictTask: time since its last check-in */
+} SUP_PERSIST;
+
+static SUP_PERSIST supRec __attribute__((persistent));
+
+/* ===================== State ===================== */
+static uint32_t supRcon;
+static SUP_RESET_CAUSE supCause = SUP_RESET_UNKNOWN;
+static uint8_t  supPrevTask = SUP_TASK_NONE;
+static uint8_t  supPrevLast = SUP_TASK_NONE;
+static uint16_t supPrevAgeMs = 0u;
+
+static uint32_t supLastT[SUP_TASK_COUNT];
+static bool supRunning = false;
+static bool supTripped = false;
+
+static SUP_RESET_CAUSE SUP_DecodeRcon(uint32_t rcon)
+{
+    if (rcon & _RCON_CMR_MASK)  return SUP_RESET_CONFIG_MISMATCH;
+    if (rcon & _RCON_WDTO_MASK) return SUP_RESET_WDT;
+    if (rcon & _RCON_SWR_MASK)  return SUP_RESET_SOFTWARE;
+    if (rcon & _RCON_EXTR_MASK) return SUP_RESET_MCLR;
+    if (rcon & _RCON_POR_MASK)  return SUP_RESET_POR;
+    if (rcon & _RCON_BOR_MASK)  return SUP_RESET_BOR;
+    return SUP_RESET_UNKNOWN;
+}
+
+void SUP_Init(void)
+{
+    supRcon = RCON;
+    RCONCLR = _RCON_CMR_MASK | _RCON_WDTO_MASK | _RCON_SWR_MASK |
+              _RCON_EXTR_MASK | _RCON_POR_MASK | _RCON_BOR_MASK;
+
+    supCause = SUP_DecodeRcon(supRcon);
+
+    /* RAM content is undefined after power-on */
+    if ((supRec.magic != SUP_PERSIST_MAGIC) || (supCause == SUP_RESET_POR)) {
+        supRec.magic = SUP_PERSIST_MAGIC;
+        supRec.bootCount = 0u;
+        supRec.wdtCount = 0u;
+        supRec.verdictTask = SUP_TASK_NONE;
+        supRec.lastCheckIn = SUP_TASK_NONE;
+        supRec.ageMs = 0u;
+    }
+
+    supRec.bootCount++;
+
+    if (supCause == SUP_RESET_WDT) {
+        supRec.wdtCount++;
+        /* verdictTask == NONE: the main loop itself hung (no SUP_Service) */
+        supPrevTask = supRec.verdictTask;
+        supPrevLast = supRec.lastCheckIn;
+        supPrevAgeMs = supRec.ageMs;
+    }
+
+    supRec.verdictTask = SUP_TASK_NONE;
+    supRec.lastCheckIn = SUP_TASK_NONE;
+    supRec.ageMs = 0u;
+}
+
+void SUP_Rearm(void)
+{
+    uint32_t now = _CP0_GET_COUNT();
+
+    for (unsigned i = 0u; i < (unsigned)SUP_TASK_COUNT; i++) supLastT[i] = now;
+}
+
+void SUP_Start(void)
+{
+    SUP_Rearm();
+
+    supTripped = false;
+    supRunning = true;
+
+    WDTCONbits.WDTCLRKEY = SUP_WDT_CLEAR_KEY;
+    WDTCONSET = _WDTCON_ON_MASK;
+}
+
+void SUP_CheckIn(SUP_TASK_ID id)
+{
+    supLastT[id] = _CP0_GET_COUNT();
+    supRec.lastCheckIn = (uint8_t)id;
+}
+
+void SUP_Service(void)
+{
+    if (!supRunning || supTripped) return;
+
+    uint32_t now = _CP0_GET_COUNT();
+
+    for (unsigned i = 0u; i < (unsigned)SUP_TASK_COUNT; i++) {
+        uint32_t age = now - supLastT[i];
+
+        if (age > ((uint32_t)supDeadlineMs[i] * SUP_TICKS_PER_MS)) {
+            /* Stop feeding the watchdog, the reset follows within one period */
+            supRec.verdictTask = (uint8_t)i;
+            supRec.ageMs = (uint16_t)((age / SUP_TICKS_PER_MS > 0xFFFFu) ? 0xFFFFu : age / SUP_TICKS_PER_MS);
+            supTripped = true;
+            FAULT_Trace(FAULT_EV_SUP_TRIP, (uint16_t)i);
+            return;
+        }
+    }
+
+    WDTCONbits.WDTCLRKEY = SUP_WDT_CLEAR_KEY;
+}
+
+SUP_RESET_CAUSE SUP_GetResetCause(void)
+{
+    return supCause;
+}
+
+static uint16_t SUP_TaskReg(uint8_t t)
+{
+    return (t == SUP_TASK_NONE) ? 0xFFFFu : (uint16_t)t;
+}
+
+void SUP_Task_250ms(void)
+{
+    uint16_t cmd = MBS_HoldRegisters[MBS_DIAG_COMMAND];
+
+    if (MBS_RegIsBitsSet(cmd, MBS_DIAG_CMD_CLEAR_RESETS)) {
+        supRec.bootCount = 0u;
+        supRec.wdtCount = 0u;
+        MBS_RegClearBits(&MBS_HoldRegisters[MBS_DIAG_COMMAND], MBS_DIAG_CMD_CLEAR_RESETS);
+    }
+
+    MBS_InputRegisters[MBS_IR_RST_RCON]       = (uint16_t)supRcon;
+    MBS_InputRegisters[MBS_IR_RST_CAUSE]      = (uint16_t)supCause;
+    MBS_InputRegisters[MBS_IR_RST_TASK]       = SUP_TaskReg(supPrevTask);
+    MBS_InputRegisters[MBS_IR_RST_LAST_TASK]  = SUP_TaskReg(supPrevLast);
+    MBS_InputRegisters[MBS_IR_RST_AGE_MS]     = supPrevAgeMs;
+    MBS_InputRegisters[MBS_IR_RST_WDT_COUNT]  = (uint16_t)supRec.wdtCount;
+    MBS_InputRegisters[MBS_IR_RST_BOOT_COUNT] = (uint16_t)supRec.bootCount;
+}
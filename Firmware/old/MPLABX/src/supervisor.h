@@ -0,0 +1,71 @@
+#ifndef SUPERVISOR_H
+#define SUPERVISOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* =========================================================================
+ * Task-liveness supervisor for the hardware watchdog
+ *
+ * Each supervised task calls SUP_CheckIn() when it has made progress.
+ * SUP_Service() runs once per main loop pass and only clears the watchdog
+ * while every task is within its deadline. When a deadline is missed the
+ * offending task is written to a no-init (persistent) record and the
+ * watchdog is left to expire (RWDTPS 1:4096 on LPRC, ~128 ms).
+ *
+ * Deadlines are measured on the core timer count, so a dead 1 ms tick
+ * interrupt is caught as well.
+ * ========================================================================= */
+typedef enum {
+    SUP_TASK_TICK = 0,      /* 1 ms tick handling (UpdateTimers/ENDSTOP) */
+    SUP_TASK_I2C,           /* I2C1 idle or transfer completed */
+    SUP_TASK_MODBUS,        /* MBS_ProcessModbus() with the receiver empty */
+    SUP_TASK_SLOW,          /* 1 s housekeeping */
+    SUP_TASK_COUNT
+} SUP_TASK_ID;
+
+#define SUP_TASK_NONE           0xFFu
+
+typedef enum {
+    SUP_RESET_UNKNOWN = 0,
+    SUP_RESET_POR,
+    SUP_RESET_BOR,
+    SUP_RESET_MCLR,
+    SUP_RESET_SOFTWARE,
+    SUP_RESET_WDT,
+    SUP_RESET_CONFIG_MISMATCH
+} SUP_RESET_CAUSE;
+
+/**
+ * Read and clear RCON, validate the persistent record and capture the
+ * previous verdict. Call first thing in main(), before SYS_Initialize().
+ */
+void SUP_Init(void);
+
+/**
+ * Arm all deadlines and enable the watchdog. Call just before the main loop.
+ */
+void SUP_Start(void);
+
+/**
+ * Give every task a fresh deadline. For known long blocking operations
+ * (flash erase), call right after them.
+ */
+void SUP_Rearm(void);
+
+/** Task progress report, main loop context only. */
+void SUP_CheckIn(SUP_TASK_ID id);
+
+/** Deadline check and conditional watchdog clear, once per main loop pass. */
+void SUP_Service(void);
+
+/**
+ * Handle MBS_DIAG_COMMAND (MBS_DIAG_CMD_CLEAR_RESETS) and publish the
+ * reset record to the input registers. Call at 250 ms cadence.
+ */
+void SUP_Task_250ms(void);
+
+/** Reset cause seen at this boot. */
+SUP_RESET_CAUSE SUP_GetResetCause(void);
+
+#endif /* SUPERVISOR_H */
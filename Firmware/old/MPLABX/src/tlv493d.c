@@ -1,167 +1,351 @@
 #include "definitions.h"
 #include "tlv493d.h"
+#include "tlv493d_atan2.h"
+#include "tlv493d_cal.h"
+#include "tlv493d_filter.h"
+#include "tlv493d_field.h"
+#include "i2cbus.h"
 
 /* ===================== Konstanter ===================== */
-#define I2C_TIMEOUT_MS      80u
-#define I2C_BUSY_MAX_MS     200u
+#define I2C_TIMEOUT_MS      80u             /* queued + on the bus; i2cbus.c times out the bus part */
 #define TLV_MAX_FAILS       3u
+#define TLV_RING_LEN        32u             /* power of two */
+#define TLV_SETTLE_MS       20u             /* after general call reset / power-up */
+#define TLV_RETRY_MS        30000u          /* full reassignment while a sensor is missing */
+#define TLV_RESUME_MS       50u             /* after bus recovery: first sample within period + this */
+#define TLV_RECOVER_GAP_MS  1000u           /* faults closer than this: sensor lost, no new recovery */
+#define TLV_STREAM_BUSY_MS  20u             /* MCM read not finished (~1.5 ms normally) */
+
+/* MOD1 IICAddr[1:0] (bit 6:5) -> address bits flipped relative to the base address.
+ * A1B6 user manual bus address table, 8-bit write address: 3E/36/1E/16 (SDA low),
+ * BC/B4/9C/94 (SDA high), i.e. 7-bit bits 2 and 4. */
+static const uint8_t tlvIicXor[4] = { 0x00u, 0x04u, 0x10u, 0x14u };
 
 /* ===================== TLV493D state machine ===================== */
+/*
+ * One bus level state machine for all sensors. Reset and address
+ * assignment run one sensor at a time (tlvCur), acquisition runs round
+ * robin over the sensors that answered.
+ */
 typedef enum {
     TLV_ST_RESET = 0,
     TLV_ST_WAIT_RESET,
+    TLV_ST_ASSIGN,          /* next sensor in the table, or start acquisition */
+    TLV_ST_WAIT_POWER,
     TLV_ST_READ_FACTORY,
     TLV_ST_WAIT_FACTORY,
     TLV_ST_WRITE_CONFIG,
     TLV_ST_WAIT_CONFIG,
     TLV_ST_READ_DATA,
-    TLV_ST_WAIT_DATA
+    TLV_ST_WAIT_DATA,
+    TLV_ST_STREAM           /* MCM: reads started from TLV493D_Tick_1ms() */
 } TLV_STATE;
 
-static TLV_STATE tlvState = TLV_ST_RESET;
+/* ===================== Per sensor context ===================== */
+typedef struct {
+    TLV493D_Config_t cfg;
+    bool     usable;                /* cfg passed TLV493D_Init() checks */
+    volatile bool present;          /* address assigned, takes part in acquisition */
+    uint8_t  baseAddr;              /* address before IICAddr is written */
+    uint8_t  iic;                   /* MOD1 IICAddr[1:0] for cfg.addr */
+    uint8_t  fails;
+
+    uint8_t  factory[10];
+    uint8_t  configBuf[4];          /* W0..W3, justeres etter factory-read */
+    uint8_t  lastFrm;               /* LOWPOWER poll */
+
+    /* MCM stream, written by the tick / I2C1 callback */
+    volatile uint32_t streamT;      /* start of the last read */
+    volatile uint8_t  streamLastFrm;
+    volatile uint8_t  streamErrRun; /* consecutive I2C errors */
+
+    /* sample tracking */
+    TLV493D_Data_t lastSample;
+    bool     sampleValid;
+    uint32_t lastUpdateMs;
+
+    /* derived / filtered values */
+    TLV493D_Filter_t filt;          /* X/Y/Z/T pre-filter */
+    TLV493D_Field_t field;          /* |B| health */
+    TLV493D_Cal_t cal;
+    bool     headingInit;
+    int32_t  headingFiltQ;          /* centidegrees << TLV_HEADING_Q */
+    int16_t  headingCdeg;           /* filtered, [-18000..18000] */
+    int16_t  headingStableCdeg;     /* hysteresis output */
+    bool     tempInit;
+    int32_t  tempFiltTenths;        /* 0.1C units */
+    int16_t  tempStableC;
+} TLV_CTX;
+
+static TLV_CTX   tlvCtx[TLV493D_MAX_SENSORS];
+static uint8_t   tlvCount = 0u;
 
-static uint8_t   tlvAddr = 0x1Fu;
+static TLV_STATE tlvState = TLV_ST_RESET;
+static uint8_t   tlvCur = 0u;               /* sensor being assigned / polled */
 
 static uint32_t  tlvT0 = 0u;
 static uint32_t  nowMs = 0u;
+static uint32_t  tlvMissingT = 0u;          /* acquisition start with a sensor missing */
 
-static volatile bool i2cDone = false;
-
-static uint8_t tlvFactory[10];
+static I2CBUS_Xfer_t tlvXfer;               /* state machine, polled */
 static uint8_t tlvData[7];
 
-static uint8_t tlvResetBuf[1] = {0x00};
+static uint8_t tlvResetBuf[1] = {0x00};     /* SDA low during reset -> TLV493D_ADDR_RESET */
 
 static uint32_t i2cStartT = 0u;
-static uint32_t i2cBusyT  = 0u;
-static uint8_t  tlvFails  = 0u;
-
-/* konfig-buffer ? justeres etter factory-read */
-static uint8_t tlvConfigBuf[4] = {
-    0x00, /* W0: register pointer */
-    0x00, /* W1: MOD1 */
-    0x00, /* W2: reserved */
-    0x00  /* W3: MOD2 */
+
+/* Bus recovery / resume */
+static bool     tlvResuming = false;
+static bool     tlvRecoverUsed = false;
+static uint32_t tlvRecoverT = 0u;
+static uint32_t tlvResumeSamples = 0u;
+
+/* ===================== Acquisition mode ===================== */
+static TLV493D_MODE tlvMode = TLV493D_MODE_MCM;
+static volatile uint8_t tlvPeriodMs = TLV493D_PERIOD_DEFAULT_MS;
+
+/*
+ * Stream (MCM) state, shared with the core timer ISR (IPL2) and the
+ * I2C1 callback (IPL3). The main loop only touches the I2C bus while
+ * tlvStreamOn is false. Only one read is in flight at a time; the
+ * callback chains straight into the next sensor that is due.
+ */
+static volatile bool     tlvStreamOn = false;
+static volatile bool     tlvStreamBusy = false;     /* read in flight */
+static volatile uint8_t  tlvStreamCur = 0u;         /* sensor of the read in flight */
+static volatile uint8_t  tlvStreamRr = 0u;          /* next sensor to consider */
+static volatile uint32_t tlvStreamT = 0u;           /* start time of the read in flight */
+static volatile uint32_t tlvTickMs = 0u;            /* last TLV493D_Tick_1ms() time */
+static uint8_t           tlvStreamData[7];
+
+static void TLV_StreamDone(I2CBUS_Xfer_t *x);
+static I2CBUS_Xfer_t     tlvStreamXfer = {
+    .rbuf = tlvStreamData,
+    .rlen = 7u,
+    .prio = I2CBUS_PRIO_HIGH,
+    .callback = TLV_StreamDone,
 };
 
-/* sample tracking */
-static TLV493D_Data_t lastSample;
-static uint8_t  lastFrm = 0xFFu;
-static bool     sampleValid = false;
-static uint32_t lastUpdateMs = 0u;
+/* Sample ring: single producer (I2C callback or main loop, never both), consumer main loop */
+static TLV493D_Sample_t  tlvRing[TLV_RING_LEN];
+static volatile uint8_t  tlvRingHead = 0u;
+static volatile uint8_t  tlvRingTail = 0u;
+
+static TLV493D_Stats_t   tlvStats;
 
 /* ===================== Derived / filtered values ===================== */
-#define TLV_HEADING_IIR_SHIFT     3   /* 1/8 */
-#define TLV_TEMP_IIR_SHIFT        4   /* 1/16 */
-#define TLV_HEADING_HYST_DEG      1   /* publish step */
-#define TLV_TEMP_HYST_C           1   /* publish step */
+#define TLV_HEADING_Q             4   /* filter state fraction bits */
 
-static bool    headingInit = false;
-static int16_t headingFiltDeg = 0;    /* [-180..180] */
-static int16_t headingStableDeg = 0;  /* hysteresis output */
+static TLV493D_FieldCfg_t tlvField = {
+    .bMin = TLV493D_FIELD_BMIN_DEFAULT,
+    .bMax = TLV493D_FIELD_BMAX_DEFAULT,
+    .tcPpm = TLV493D_FIELD_TC_DEFAULT,
+};
 
-static bool    tempInit = false;
-static int32_t tempFiltTenths = 0;    /* 0.1C units */
-static int16_t tempStableC = 0;
+static TLV493D_FilterSet_t tlvFilt = {
+    .xyzt = { .median = 1u, .decim = 1u, .iirOrder = 0u, .iirShift = 1u },
+    .headingShift = TLV493D_HEADING_SHIFT_DEFAULT,
+    .headingHystCdeg = TLV493D_HEADING_HYST_DEFAULT,
+    .tempShift = TLV493D_TEMP_SHIFT_DEFAULT,
+    .tempHystTenths = TLV493D_TEMP_HYST_DEFAULT,
+};
 
-/* Wrap angle to [-180..180] */
-static int16_t TLV_Wrap180(int16_t a)
+/* Wrap centidegrees << TLV_HEADING_Q to [-180..180] */
+static int32_t TLV_WrapQ(int32_t a)
 {
-    while (a > 180)  a = (int16_t)(a - 360);
-    while (a < -180) a = (int16_t)(a + 360);
+    const int32_t half = (int32_t)TLV493D_CDEG_180 << TLV_HEADING_Q;
+
+    while (a > half)  a -= 2 * half;
+    while (a < -half) a += 2 * half;
     return a;
 }
 
-/* Very fast atan2 approximation in degrees (no float).
- * Typical error ~1-2 degrees, which is fine when combined with IIR filtering.
+/*
+ * Update heading filter + hysteresis output. The IIR runs on centidegrees
+ * with TLV_HEADING_Q fraction bits so the 1/2^n step does not truncate the
+ * 0.01 degree resolution of TLV493D_Atan2Cdeg(). Shift 0 passes through.
  */
-static int16_t TLV_Atan2ApproxDeg(int16_t y, int16_t x)
+static void TLV_UpdateHeading(TLV_CTX *c, int16_t x, int16_t y)
 {
-    if (x == 0 && y == 0) return 0;
+    /* Hard/soft-iron correction */
+    int16_t xc = (int16_t)((((int32_t)x - c->cal.offX) * (int32_t)c->cal.scaleX) >> 14);
+    int16_t yc = (int16_t)((((int32_t)y - c->cal.offY) * (int32_t)c->cal.scaleY) >> 14);
+    int32_t hNew = (int32_t)TLV493D_Atan2Cdeg(yc, xc) << TLV_HEADING_Q;
+    bool first = !c->headingInit;
+
+    if (first) {
+        c->headingInit = true;
+        c->headingFiltQ = hNew;
+    } else {
+        int32_t d = TLV_WrapQ(hNew - c->headingFiltQ);
+        c->headingFiltQ = TLV_WrapQ(c->headingFiltQ + (d >> tlvFilt.headingShift));
+    }
 
-    int32_t abs_y = (y < 0) ? -(int32_t)y : (int32_t)y;
-    int32_t abs_x = (x < 0) ? -(int32_t)x : (int32_t)x;
+    int32_t cdeg = (c->headingFiltQ + (1 << (TLV_HEADING_Q - 1))) >> TLV_HEADING_Q;
+    if (cdeg > TLV493D_CDEG_180) cdeg -= 2 * TLV493D_CDEG_180;
+    c->headingCdeg = (int16_t)cdeg;
 
-    /* avoid 0/0 in the r computation */
-    if (abs_y == 0) {
-        return (x < 0) ? 180 : 0;
+    /* Hysteresis publish */
+    int32_t dh = cdeg - c->headingStableCdeg;
+    if (dh > TLV493D_CDEG_180)  dh -= 2 * TLV493D_CDEG_180;
+    if (dh < -TLV493D_CDEG_180) dh += 2 * TLV493D_CDEG_180;
+    if (first || dh >= (int32_t)tlvFilt.headingHystCdeg || dh <= -(int32_t)tlvFilt.headingHystCdeg) {
+        c->headingStableCdeg = (int16_t)cdeg;
     }
-    if (abs_x == 0) {
-        return (y < 0) ? -90 : 90;
+}
+
+/* Temperature conversion:
+ * Datasheet: digital value at 25C is T25=340 LSB, resolution ~1.1C/LSB.
+ * Use 0.1C units to keep precision without floats:
+ *   T(0.1C) = 250 + (Traw - 340) * 11
+ */
+static void TLV_UpdateTemp(TLV_CTX *c, int16_t rawT12)
+{
+    int32_t tTenths = 250 + ((int32_t)rawT12 - 340) * 11;
+
+    if (!c->tempInit) {
+        c->tempInit = true;
+        c->tempFiltTenths = tTenths;
+        c->tempStableC = (int16_t)((tTenths + 5) / 10); /* rounded */
+        return;
     }
 
-    /* r in Q15 */
-    int32_t r_q15;
-    int32_t angle; /* degrees */
-    if (x >= 0) {
-        /* angle = 45 - 45 * (x - |y|)/(x + |y|) */
-        int32_t num = (int32_t)x - abs_y;
-        int32_t den = (int32_t)x + abs_y;
-        r_q15 = (den != 0) ? ((num << 15) / den) : 0;
-        angle = 45 - ((45 * r_q15) >> 15);
-    } else {
-        /* angle = 135 - 45 * (x + |y|)/(|y| - x) */
-        int32_t num = (int32_t)x + abs_y;
-        int32_t den = abs_y - (int32_t)x;
-        r_q15 = (den != 0) ? ((num << 15) / den) : 0;
-        angle = 135 - ((45 * r_q15) >> 15);
+    c->tempFiltTenths += (tTenths - c->tempFiltTenths) >> tlvFilt.tempShift;
+
+    /* Hysteresis on the filtered value, publish rounded whole C */
+    int32_t dt = c->tempFiltTenths - (int32_t)c->tempStableC * 10;
+    if (dt >= (int32_t)tlvFilt.tempHystTenths || dt <= -(int32_t)tlvFilt.tempHystTenths) {
+        c->tempStableC = (int16_t)((c->tempFiltTenths + 5) / 10); /* rounded */
     }
+}
 
-    if (y < 0) angle = -angle;
-    return TLV_Wrap180((int16_t)angle);
+/* ===================== Frame decode ===================== */
+/*
+ * Decode a 7-byte read (registers 0..6).
+ * Validering:
+ *  - CH==0 (konsistent sample)
+ *  - PD==1 (ferdig)
+ *  - FF==1 (ok)
+ *  - T==0 (ikke testmode)
+ * FRM (ny sample) sjekkes av kaller.
+ */
+static bool TLV_Decode(const uint8_t d[7], TLV493D_Sample_t *s)
+{
+    uint8_t ch  = (uint8_t)((d[3] >> 0) & 0x03u);
+    uint8_t reg5 = d[5];
+    uint8_t pd   = (uint8_t)((reg5 >> 4) & 0x01u);  /* 1=conversion completed */
+    uint8_t ff   = (uint8_t)((reg5 >> 5) & 0x01u);
+    uint8_t t    = (uint8_t)((reg5 >> 6) & 0x01u);
+
+    if (ch != 0u || pd == 0u || ff == 0u || t != 0u) return false;
+
+    /* X/Y/Z 12-bit signed */
+    int16_t x = (int16_t)(((uint16_t)d[0] << 4) | (uint16_t)(d[4] >> 4));
+    if (x & 0x0800) x = (int16_t)(x - 0x1000);
+
+    int16_t y = (int16_t)(((uint16_t)d[1] << 4) | (uint16_t)(d[4] & 0x0Fu));
+    if (y & 0x0800) y = (int16_t)(y - 0x1000);
+
+    int16_t z = (int16_t)(((uint16_t)d[2] << 4) | (uint16_t)(d[5] & 0x0Fu));
+    if (z & 0x0800) z = (int16_t)(z - 0x1000);
+
+    /* Temp 12-bit: MS nibble in reg3, LSB byte in reg6 */
+    int16_t rawT12 = (int16_t)(((uint16_t)(d[3] & 0xF0u) << 4) |
+                               ((uint16_t) d[6]));
+    if (rawT12 & 0x0800) rawT12 = (int16_t)(rawT12 - 0x1000);
+
+    s->x = x;
+    s->y = y;
+    s->z = z;
+    s->temperature = rawT12;
+    s->frame = (uint8_t)((d[3] >> 2) & 0x03u);
+    return true;
 }
 
-/* Update heading filter + hysteresis output */
-static void TLV_UpdateHeading(int16_t x, int16_t y)
+/* Push one sample, drops the newest on overflow */
+static void TLV_RingPush(const TLV493D_Sample_t *s)
 {
-    int16_t hNew = TLV_Atan2ApproxDeg(y, x);
+    uint8_t next = (uint8_t)((tlvRingHead + 1u) & (TLV_RING_LEN - 1u));
 
-    if (!headingInit) {
-        headingInit = true;
-        headingFiltDeg = hNew;
-        headingStableDeg = hNew;
+    if (next == tlvRingTail) {
+        tlvStats.overflows++;
         return;
     }
-
-    int16_t d = TLV_Wrap180((int16_t)(hNew - headingFiltDeg));
-    headingFiltDeg = TLV_Wrap180((int16_t)(headingFiltDeg + (d >> TLV_HEADING_IIR_SHIFT)));
-
-    /* Hysteresis publish */
-    int16_t dh = TLV_Wrap180((int16_t)(headingFiltDeg - headingStableDeg));
-    if (dh >= TLV_HEADING_HYST_DEG || dh <= -TLV_HEADING_HYST_DEG) {
-        headingStableDeg = headingFiltDeg;
-    }
+    tlvRing[tlvRingHead] = *s;
+    tlvRingHead = next;
 }
 
-/* Temperature conversion:
- * Datasheet: digital value at 25C is T25=340 LSB, resolution ~1.1C/LSB.
- * Use 0.1C units to keep precision without floats:
- *   T(0.1C) = 250 + (Traw - 340) * 11
+
+/* ===================== Stream round robin (ISR context) ===================== */
+/*
+ * Start a read for the next present sensor whose period has elapsed.
+ * Called from the tick (IPL2) and chained from the I2C1 callback (IPL3);
+ * the callback can only preempt the tick while a read is in flight, and
+ * then the tick has already returned on tlvStreamBusy.
  */
-static void TLV_UpdateTemp(int16_t rawT12)
+static void TLV_StreamNext(uint32_t now_ms)
 {
-    int32_t tTenths = 250 + ((int32_t)rawT12 - 340) * 11;
+    uint8_t i = tlvStreamRr;
+
+    for (uint8_t k = 0u; k < tlvCount; k++) {
+        TLV_CTX *c = &tlvCtx[i];
+        uint8_t id = i;
+
+        if (++i >= tlvCount) i = 0u;
+
+        if (!c->present) continue;
+        if ((uint32_t)(now_ms - c->streamT) < tlvPeriodMs) continue;
 
-    if (!tempInit) {
-        tempInit = true;
-        tempFiltTenths = tTenths;
-        tempStableC = (int16_t)((tTenths + 5) / 10); /* rounded */
+        tlvStreamRr = i;
+        tlvStreamCur = id;
+        tlvStreamT = now_ms;
+        c->streamT = now_ms;
+        tlvStreamBusy = true;
+        tlvStreamXfer.addr = c->cfg.addr;
+        if (!I2CBUS_Submit(&tlvStreamXfer)) {
+            tlvStreamBusy = false;      /* previous one still queued, next tick */
+        }
         return;
     }
+}
+
+/* ===================== Stream read completion ===================== */
+/* I2C1 ISR context, or main loop with interrupts off (bus recovery / timeout) */
+static void TLV_StreamDone(I2CBUS_Xfer_t *x)
+{
+    TLV_CTX *c = &tlvCtx[tlvStreamCur];
+    TLV493D_Sample_t s;
+
+    if (!tlvStreamBusy) return;     /* stream stopped meanwhile, result is stale */
 
-    tempFiltTenths += (tTenths - tempFiltTenths) >> TLV_TEMP_IIR_SHIFT;
+    tlvStreamBusy = false;
 
-    int16_t tC = (int16_t)((tempFiltTenths + 5) / 10); /* rounded */
-    if (tC >= (tempStableC + TLV_TEMP_HYST_C) || tC <= (tempStableC - TLV_TEMP_HYST_C)) {
-        tempStableC = tC;
+    if (x->state != I2CBUS_XFER_DONE) {
+        tlvStats.errors++;
+        if (c->streamErrRun < 0xFFu) c->streamErrRun++;
+    } else if (!TLV_Decode(tlvStreamData, &s) || s.frame == c->streamLastFrm) {
+        c->streamErrRun = 0u;
+        tlvStats.stale++;
+    } else {
+        c->streamErrRun = 0u;
+        c->streamLastFrm = s.frame;
+        s.t_ms = tlvStreamT;
+        s.sensor = tlvStreamCur;
+        TLV_RingPush(&s);
     }
+
+    /* Chained: the next read starts right behind this one */
+    if (tlvStreamOn) TLV_StreamNext(tlvTickMs);
 }
 
-/* ===================== I2C callback ===================== */
-void TLV493D_I2C_Callback(uintptr_t context)
+/* ===================== Stream trigger (core timer ISR) ===================== */
+void TLV493D_Tick_1ms(uint32_t now_ms)
 {
-    (void)context;
-    i2cDone = true;
+    tlvTickMs = now_ms;
+
+    if (!tlvStreamOn || tlvStreamBusy) return;
+
+    TLV_StreamNext(now_ms);
 }
 
 /* ===================== Parity helpers (MOD1 bit7) ===================== */
@@ -189,292 +373,657 @@ static void TLV_SetOddParity(uint8_t w[4])
 }
 
 /* ===================== TLV state machine helpers ===================== */
-static inline void I2C_GuardStart(void) { i2cStartT = nowMs; }
 static inline bool I2C_GuardTimeout(void){ return (uint32_t)(nowMs - i2cStartT) > I2C_TIMEOUT_MS; }
 
-static inline void TLV_FailStep(void)
+/* Queue a state machine transfer; false while the previous one is still pending */
+static bool TLV_Xfer(uint16_t addr, uint8_t *w, uint8_t wlen, uint8_t *r, uint8_t rlen, I2CBUS_PRIO prio)
+{
+    tlvXfer.addr = addr;
+    tlvXfer.wbuf = w;
+    tlvXfer.wlen = wlen;
+    tlvXfer.rbuf = r;
+    tlvXfer.rlen = rlen;
+    tlvXfer.prio = (uint8_t)prio;
+    tlvXfer.callback = NULL;
+
+    if (!I2CBUS_Submit(&tlvXfer)) return false;
+    i2cStartT = nowMs;
+    return true;
+}
+
+static void TLV_StreamStop(void)
+{
+    tlvStreamOn = false;        /* no new reads from the tick */
+    tlvStreamBusy = false;
+}
+
+static inline void TLV_Power(const TLV_CTX *c, bool on)
+{
+    if (c->cfg.power != NULL) c->cfg.power(on);
+}
+
+static void TLV_ClearSample(TLV_CTX *c)
 {
-    sampleValid = false;
+    c->lastFrm = 0xFFu;
+    c->sampleValid = false;
+    c->lastUpdateMs = 0u;
 
-    if (++tlvFails >= TLV_MAX_FAILS) {
-        tlvFails = 0u;
-        tlvState = TLV_ST_RESET;      /* full reinit */
+    /* Clear derived */
+    TLV493D_FilterReset(&c->filt);
+    TLV493D_FieldReset(&c->field);
+    c->headingInit = false;
+    c->headingFiltQ = 0;
+    c->headingCdeg = 0;
+    c->headingStableCdeg = 0;
+    c->tempInit = false;
+    c->tempFiltTenths = 0;
+    c->tempStableC = 0;
+
+    /* Clear sample */
+    c->lastSample.x = 0;
+    c->lastSample.y = 0;
+    c->lastSample.z = 0;
+    c->lastSample.temperature = 0;
+    c->lastSample.frame = 0;
+    c->lastSample.channel = 0;
+    c->lastSample.powerDown = false;
+}
+
+/* First present sensor at or after 'from' (wrapping), TLV493D_MAX_SENSORS if none */
+static uint8_t TLV_NextPresent(uint8_t from)
+{
+    for (uint8_t k = 0u; k < tlvCount; k++) {
+        uint8_t i = (uint8_t)((from + k) % tlvCount);
+        if (tlvCtx[i].present) return i;
+    }
+    return TLV493D_MAX_SENSORS;
+}
+
+static bool TLV_AnyMissing(void)
+{
+    for (uint8_t i = 0u; i < tlvCount; i++) {
+        if (tlvCtx[i].usable && !tlvCtx[i].present) return true;
+    }
+    return false;
+}
+
+static void TLV_BusReset(void)
+{
+    TLV_StreamStop();
+    tlvResuming = false;
+    tlvState = TLV_ST_RESET;
+    for (uint8_t i = 0u; i < tlvCount; i++) {
+        tlvCtx[i].present = false;
+        tlvCtx[i].sampleValid = false;
+    }
+}
+
+/* Factory read / config write failed for tlvCur */
+static void TLV_AssignFail(void)
+{
+    TLV_CTX *c = &tlvCtx[tlvCur];
+
+    if (++c->fails >= TLV_MAX_FAILS) {
+        /* Give up on this one; a powered sensor at the base address blocks the next */
+        TLV_Power(c, false);
+        tlvCur++;
+        tlvState = TLV_ST_ASSIGN;
+    } else {
+        tlvState = TLV_ST_READ_FACTORY;   /* prv igjen */
+    }
+}
+
+/* All sensors assigned: hand over to acquisition */
+static void TLV_StartAcquisition(void)
+{
+    if (TLV_NextPresent(0u) >= TLV493D_MAX_SENSORS) {
+        tlvState = TLV_ST_RESET;          /* nobody answered, full reinit */
+        return;
+    }
+
+    tlvMissingT = nowMs;
+
+    if (tlvMode == TLV493D_MODE_MCM) {
+        /* Hand the bus over to the tick / callback path */
+        for (uint8_t i = 0u; i < tlvCount; i++) {
+            tlvCtx[i].streamErrRun = 0u;
+            tlvCtx[i].streamLastFrm = 0xFFu;
+            tlvCtx[i].streamT = nowMs - tlvPeriodMs;
+        }
+        tlvStreamRr = 0u;
+        tlvStreamOn = true;
+        tlvState = TLV_ST_STREAM;
+    } else {
+        tlvCur = 0u;
+        tlvState = TLV_ST_READ_DATA;
+    }
+}
+
+/*
+ * Bus fault during acquisition: free the bus and go on with the config
+ * the sensors already have. TLV493D_Task() waits TLV_RESUME_MS for a
+ * sample and falls back to the full reset if none arrives.
+ */
+static void TLV_Recover(void)
+{
+    TLV_StreamStop();
+    tlvRecoverT = nowMs;
+    tlvRecoverUsed = true;
+
+    if (tlvResuming || !I2CBUS_Recover()) {
+        tlvStats.reinits++;
+        TLV_BusReset();
+        return;
+    }
+
+    for (uint8_t i = 0u; i < tlvCount; i++) {
+        tlvCtx[i].fails = 0u;
+    }
+    tlvResuming = true;
+    tlvResumeSamples = tlvStats.samples;
+    TLV_StartAcquisition();
+}
+
+/* A present sensor stopped answering */
+static void TLV_Lost(TLV_CTX *c)
+{
+    c->present = false;
+    c->sampleValid = false;
+    tlvMissingT = nowMs;
+
+    if (TLV_NextPresent(0u) >= TLV493D_MAX_SENSORS) {
+        tlvStats.reinits++;
+        TLV_BusReset();                   /* full reinit */
+    }
+}
+
+/*
+ * A present sensor reached TLV_MAX_FAILS. The first time, blame the bus;
+ * a repeat shortly after a recovery means the sensor itself is gone.
+ * True when acquisition was restarted.
+ */
+static bool TLV_Fault(TLV_CTX *c)
+{
+    if (!tlvRecoverUsed || (uint32_t)(nowMs - tlvRecoverT) >= TLV_RECOVER_GAP_MS) {
+        TLV_Recover();
+        return true;
+    }
+    TLV_Lost(c);
+    return false;
+}
+
+static inline void TLV_FailStep(TLV_CTX *c)
+{
+    c->sampleValid = false;
+
+    if (++c->fails >= TLV_MAX_FAILS) {
+        c->fails = 0u;
+        if (TLV_Fault(c)) return;
+    }
+    if (tlvState != TLV_ST_RESET) {
+        tlvCur++;
+        tlvState = TLV_ST_READ_DATA;      /* prv  fortsette lesing */
+    }
+}
+
+/* Build W0..W3 from the factory registers */
+static void TLV_BuildConfig(TLV_CTX *c)
+{
+    c->configBuf[2] = c->factory[8];  /* W2 mirrors factory reg8 */
+
+    /*
+     * MOD1 (W1):
+     *  - behold reserved bits fra factory, IICAddr fra cfg.addr
+     *  - LOWPOWER: INT=0, FAST=0, LOW=1 (12 ms)
+     *  - MCM:      INT=0, FAST=1, LOW=1, W0 trigger = ADC start
+     *              on read after register 05h
+     *  - parity settes etterp
+     */
+    uint8_t mod1 = (uint8_t)(c->factory[7] & 0x7Fu);        /* clear parity */
+    mod1 = (uint8_t)((mod1 & 0x98u) | (uint8_t)(c->iic << 5));
+    if (tlvMode == TLV493D_MODE_MCM) {
+        c->configBuf[0] = 0x40u;                            /* W0: trigger on read */
+        mod1 = (uint8_t)(mod1 | 0x03u);                     /* FAST + LOW */
     } else {
-        tlvState = TLV_ST_READ_DATA;  /* prv  fortsette lesing */
+        c->configBuf[0] = 0x00u;                            /* W0 */
+        mod1 = (uint8_t)(mod1 | 0x01u);                     /* LOW */
     }
+    c->configBuf[1] = mod1;
+
+    /*
+     * MOD2 (W3):
+     *  - behold reserved [4:0]
+     *  - LP=1 (12ms), T=0 (temp enabled)
+     *  - PT beholdes fra factory (typisk 1)
+     */
+    uint8_t mod2 = c->factory[9];
+    mod2 = (uint8_t)((mod2 & 0x3Fu) | 0x40u);               /* LP=1 */
+    mod2 = (uint8_t)(mod2 & ~(1u << 7));                    /* T=0 */
+    c->configBuf[3] = mod2;
+
+    /* Sett odd parity over W0..W3 */
+    TLV_SetOddParity(c->configBuf);
 }
 
 /* ===================== Public API ===================== */
-void TLV493D_Init(uint8_t i2c_addr)
+void TLV493D_Init(const TLV493D_Config_t *cfg, uint8_t count)
 {
-    tlvAddr = i2c_addr;
+    bool unswitched = false;
 
-    tlvState = TLV_ST_RESET;
-    tlvT0 = 0u;
-    i2cDone = false;
+    if (count > TLV493D_MAX_SENSORS) count = TLV493D_MAX_SENSORS;
+    if (cfg == NULL) count = 0u;
 
-    i2cStartT = 0u;
-    i2cBusyT = 0u;
-    tlvFails = 0u;
+    TLV_StreamStop();
+    tlvRingTail = tlvRingHead;
 
-    lastFrm = 0xFFu;
-    sampleValid = false;
-    lastUpdateMs = 0u;
+    tlvCount = count;
+    for (uint8_t i = 0u; i < count; i++) {
+        TLV_CTX *c = &tlvCtx[i];
 
-    /* Clear derived */
-    headingInit = false;
-    headingFiltDeg = 0;
-    headingStableDeg = 0;
-    tempInit = false;
-    tempFiltTenths = 0;
-    tempStableC = 0;
+        c->cfg = cfg[i];
+        c->present = false;
+        c->fails = 0u;
+        c->baseAddr = (c->cfg.power != NULL) ? TLV493D_ADDR_POWERUP : TLV493D_ADDR_RESET;
+        c->usable = false;
 
-    /* Clear sample */
-    lastSample.x = 0;
-    lastSample.y = 0;
-    lastSample.z = 0;
-    lastSample.temperature = 0;
-    lastSample.frame = 0;
-    lastSample.channel = 0;
-    lastSample.powerDown = false;
+        for (uint8_t n = 0u; n < 4u; n++) {
+            if ((uint8_t)(c->baseAddr ^ tlvIicXor[n]) == c->cfg.addr) {
+                c->iic = n;
+                c->usable = true;
+            }
+        }
+
+        /* Every unswitched sensor lands on the same address after the general call reset */
+        if (c->cfg.power == NULL) {
+            if (unswitched) c->usable = false;
+            unswitched = true;
+        }
+        for (uint8_t j = 0u; j < i; j++) {
+            if (tlvCtx[j].usable && tlvCtx[j].cfg.addr == c->cfg.addr) c->usable = false;
+            /* A switched sensor left on the power-up address collides with the next one */
+            if (c->cfg.power != NULL && tlvCtx[j].usable &&
+                tlvCtx[j].cfg.power != NULL && tlvCtx[j].cfg.addr == TLV493D_ADDR_POWERUP) {
+                tlvCtx[j].usable = false;
+            }
+        }
+
+        TLV_ClearSample(c);
+        TLV493D_SetCal(i, NULL);
+    }
+
+    tlvState = TLV_ST_RESET;
+    tlvCur = 0u;
+    tlvT0 = 0u;
+    i2cStartT = 0u;
 }
 
 void TLV493D_Task(uint32_t now_ms)
 {
+    TLV_CTX *c = &tlvCtx[(tlvCur < tlvCount) ? tlvCur : 0u];
+
     nowMs = now_ms;
 
-    /* --- Busy watchdog --- */
-    if (I2C1_IsBusy()) {
-        if (i2cBusyT == 0u) i2cBusyT = nowMs;
-        if ((uint32_t)(nowMs - i2cBusyT) > I2C_BUSY_MAX_MS) {
-            i2cBusyT = 0u;
-            i2cDone = false;
-            tlvState = TLV_ST_RESET;
-            sampleValid = false;
-        }
-    } else {
-        i2cBusyT = 0u;
+    /* --- Periodic full reassignment while a sensor is missing --- */
+    if ((tlvState == TLV_ST_STREAM || tlvState == TLV_ST_READ_DATA) &&
+        TLV_AnyMissing() && (uint32_t)(nowMs - tlvMissingT) >= TLV_RETRY_MS) {
+        TLV_BusReset();
     }
 
     switch (tlvState)
     {
         case TLV_ST_RESET:
-            if (!I2C1_IsBusy()) {
-                i2cDone = false;
-                I2C_GuardStart();
-                I2C1_Write(0x00, tlvResetBuf, 1);   /* general call reset */
+            if (tlvCount == 0u) break;
+            if (!I2CBUS_Pending(&tlvXfer)) {
+                /* Switched sensors off, the rest back to TLV493D_ADDR_RESET */
+                for (uint8_t i = 0u; i < tlvCount; i++) {
+                    TLV_Power(&tlvCtx[i], false);
+                    tlvCtx[i].present = false;
+                    tlvCtx[i].sampleValid = false;
+                    tlvCtx[i].fails = 0u;
+                }
+                (void)TLV_Xfer(0x00, tlvResetBuf, 1u, NULL, 0u, I2CBUS_PRIO_NORMAL);   /* general call reset */
                 tlvT0 = nowMs;
                 tlvState = TLV_ST_WAIT_RESET;
-                sampleValid = false;
-                lastFrm = 0xFFu;
             }
             break;
 
         case TLV_ST_WAIT_RESET:
             /* 20ms holder i praksis */
-            if ((uint32_t)(nowMs - tlvT0) >= 20u) {
+            if ((uint32_t)(nowMs - tlvT0) >= TLV_SETTLE_MS) {
+                tlvCur = 0u;
+                tlvState = TLV_ST_ASSIGN;
+            }
+            break;
+
+        case TLV_ST_ASSIGN:
+            while (tlvCur < tlvCount && !tlvCtx[tlvCur].usable) tlvCur++;
+            if (tlvCur >= tlvCount) {
+                TLV_StartAcquisition();
+                break;
+            }
+            c = &tlvCtx[tlvCur];
+            c->fails = 0u;
+            if (c->cfg.power != NULL) {
+                /* Alone on the power-up address until IICAddr is written */
+                TLV_Power(c, true);
+                tlvT0 = nowMs;
+                tlvState = TLV_ST_WAIT_POWER;
+            } else {
+                tlvState = TLV_ST_READ_FACTORY;
+            }
+            break;
+
+        case TLV_ST_WAIT_POWER:
+            if ((uint32_t)(nowMs - tlvT0) >= TLV_SETTLE_MS) {
                 tlvState = TLV_ST_READ_FACTORY;
             }
             break;
 
         case TLV_ST_READ_FACTORY:
-            if (!I2C1_IsBusy()) {
-                i2cDone = false;
-                I2C_GuardStart();
-                I2C1_Read(tlvAddr, tlvFactory, 10);
+            if (TLV_Xfer(c->baseAddr, NULL, 0u, c->factory, 10u, I2CBUS_PRIO_NORMAL)) {
                 tlvState = TLV_ST_WAIT_FACTORY;
             }
             break;
 
         case TLV_ST_WAIT_FACTORY:
-            if (i2cDone) {
-                if (I2C1_ErrorGet() != I2C_ERROR_NONE) {
-                    TLV_FailStep();
-                    break;
-                }
-
-                /* Bygg write regs W0..W3 */
-                tlvConfigBuf[0] = 0x00u;          /* W0 */
-                tlvConfigBuf[2] = tlvFactory[8];  /* W2 mirrors factory reg8 */
-
-                /*
-                 * MOD1 (W1):
-                 *  - behold IICAddr og reserved bits fra factory
-                 *  - INT=0, FAST=0, LOW=1
-                 *  - parity settes etterp
-                 */
-                uint8_t mod1 = (uint8_t)(tlvFactory[7] & 0x7Fu);     /* clear parity */
-                mod1 = (uint8_t)((mod1 & 0xF8u) | 0x01u);            /* ..xxx000 + LOW */
-                tlvConfigBuf[1] = mod1;
-
-                /*
-                 * MOD2 (W3):
-                 *  - behold reserved [4:0]
-                 *  - LP=1 (12ms), T=0 (temp enabled)
-                 *  - PT beholdes fra factory (typisk 1)
-                 */
-                uint8_t mod2 = tlvFactory[9];
-                mod2 = (uint8_t)((mod2 & 0x3Fu) | 0x40u);            /* LP=1 */
-                mod2 = (uint8_t)(mod2 & ~(1u << 7));                 /* T=0 */
-                tlvConfigBuf[3] = mod2;
-
-                /* Sett odd parity over W0..W3 */
-                TLV_SetOddParity(tlvConfigBuf);
-
+            if (tlvXfer.state == I2CBUS_XFER_DONE) {
+                TLV_BuildConfig(c);
                 tlvState = TLV_ST_WRITE_CONFIG;
-            } else {
-                if (I2C1_ErrorGet() != I2C_ERROR_NONE || I2C_GuardTimeout()) {
-                    TLV_FailStep();
-                }
+            } else if (tlvXfer.state == I2CBUS_XFER_FAILED || I2C_GuardTimeout()) {
+                TLV_AssignFail();
             }
             break;
 
         case TLV_ST_WRITE_CONFIG:
-            if (!I2C1_IsBusy()) {
-                i2cDone = false;
-                I2C_GuardStart();
-                I2C1_Write(tlvAddr, tlvConfigBuf, 4);
+            if (TLV_Xfer(c->baseAddr, c->configBuf, 4u, NULL, 0u, I2CBUS_PRIO_NORMAL)) {
                 tlvState = TLV_ST_WAIT_CONFIG;
             }
             break;
 
         case TLV_ST_WAIT_CONFIG:
-            if (i2cDone) {
-                if (I2C1_ErrorGet() != I2C_ERROR_NONE) {
-                    TLV_FailStep();
-                    break;
-                }
-                tlvFails = 0u;
-                tlvState = TLV_ST_READ_DATA;
-            } else {
-                if (I2C1_ErrorGet() != I2C_ERROR_NONE || I2C_GuardTimeout()) {
-                    TLV_FailStep();
-                }
+            if (tlvXfer.state == I2CBUS_XFER_DONE) {
+                /* Answers on cfg.addr from here */
+                c->fails = 0u;
+                c->lastFrm = 0xFFu;
+                c->present = true;
+                tlvCur++;
+                tlvState = TLV_ST_ASSIGN;
+            } else if (tlvXfer.state == I2CBUS_XFER_FAILED || I2C_GuardTimeout()) {
+                TLV_AssignFail();
             }
             break;
 
         case TLV_ST_READ_DATA:
-            if (!I2C1_IsBusy()) {
-                i2cDone = false;
-                I2C_GuardStart();
-                I2C1_Read(tlvAddr, tlvData, 7);
+            /* LOWPOWER: one read per call, round robin */
+            tlvCur = TLV_NextPresent((tlvCur < tlvCount) ? tlvCur : 0u);
+            if (tlvCur >= TLV493D_MAX_SENSORS) {
+                TLV_BusReset();
+                break;
+            }
+            if (TLV_Xfer(tlvCtx[tlvCur].cfg.addr, NULL, 0u, tlvData, 7u, I2CBUS_PRIO_HIGH)) {
                 tlvState = TLV_ST_WAIT_DATA;
             }
             break;
 
         case TLV_ST_WAIT_DATA:
-            if (i2cDone) {
-                if (I2C1_ErrorGet() != I2C_ERROR_NONE) {
-                    TLV_FailStep();
-                    break;
+            if (tlvXfer.state == I2CBUS_XFER_DONE) {
+                TLV493D_Sample_t s;
+
+                /* FRM m endre seg (ny sample) */
+                if (!TLV_Decode(tlvData, &s) || s.frame == c->lastFrm) {
+                    tlvStats.stale++;
+                    c->sampleValid = false;
+                } else {
+                    c->lastFrm = s.frame;
+                    s.t_ms = nowMs;
+                    s.sensor = tlvCur;
+                    TLV_RingPush(&s);
+                    c->fails = 0u;
                 }
 
-                uint8_t frm = (uint8_t)((tlvData[3] >> 2) & 0x03u);
-                uint8_t ch  = (uint8_t)((tlvData[3] >> 0) & 0x03u);
-
-                uint8_t reg5 = tlvData[5];
-                uint8_t pd   = (uint8_t)((reg5 >> 4) & 0x01u);  /* 1=conversion completed */
-                uint8_t ff   = (uint8_t)((reg5 >> 5) & 0x01u);
-                uint8_t t    = (uint8_t)((reg5 >> 6) & 0x01u);
-
-                /*
-                 * Validering:
-                 *  - CH==0 (konsistent sample)
-                 *  - PD==1 (ferdig)
-                 *  - FF==1 (ok)
-                 *  - T==0 (ikke testmode)
-                 *  - FRM m endre seg (ny sample)
-                 */
-                if (ch != 0u || pd == 0u || ff == 0u || t != 0u || frm == lastFrm) {
-                    sampleValid = false;
-                    tlvState = TLV_ST_READ_DATA;
-                    break;
+                tlvCur++;
+                tlvState = TLV_ST_READ_DATA;
+            } else if (tlvXfer.state == I2CBUS_XFER_FAILED || I2C_GuardTimeout()) {
+                tlvStats.errors++;
+                TLV_FailStep(c);
+            }
+            break;
+
+        case TLV_ST_STREAM:
+            /* Reads run from the tick; only supervise here */
+            if (tlvStreamBusy && (uint32_t)(nowMs - tlvStreamT) > TLV_STREAM_BUSY_MS) {
+                TLV_Recover();
+                break;
+            }
+            for (uint8_t i = 0u; i < tlvCount; i++) {
+                if (tlvCtx[i].present && tlvCtx[i].streamErrRun >= TLV_MAX_FAILS) {
+                    if (TLV_Fault(&tlvCtx[i])) break;
                 }
+            }
+            break;
 
-                /* X/Y/Z 12-bit signed */
-                int16_t x = (int16_t)(((uint16_t)tlvData[0] << 4) | (uint16_t)(tlvData[4] >> 4));
-                if (x & 0x0800) x = (int16_t)(x - 0x1000);
+        default:
+            TLV_BusReset();
+            break;
+    }
 
-                int16_t y = (int16_t)(((uint16_t)tlvData[1] << 4) | (uint16_t)(tlvData[4] & 0x0Fu));
-                if (y & 0x0800) y = (int16_t)(y - 0x1000);
+    /* Drain the sample ring: derived values + sample hook */
+    while (tlvRingTail != tlvRingHead) {
+        const TLV493D_Sample_t *s = &tlvRing[tlvRingTail];
+        TLV_CTX *sc = &tlvCtx[s->sensor];
+
+        const int16_t in[TLV493D_FILT_CH] = { s->x, s->y, s->z, s->temperature };
+        int16_t f[TLV493D_FILT_CH];
+
+        /* Calibration and the sample FIFO see the raw data */
+        TLV493D_CalFeed(s);
+        tlvStats.samples++;
+
+        /* Derived values, at the decimated rate */
+        if (TLV493D_FilterRun(&sc->filt, &tlvFilt.xyzt, in, f)) {
+            sc->lastSample.x = f[0];
+            sc->lastSample.y = f[1];
+            sc->lastSample.z = f[2];
+            sc->lastSample.temperature = f[3];
+            sc->lastSample.frame = s->frame;
+            sc->lastSample.channel = 0u;
+            sc->lastSample.powerDown = true;
+
+            TLV_UpdateHeading(sc, f[0], f[1]);
+            TLV_UpdateTemp(sc, f[3]);
+            (void)TLV493D_FieldUpdate(&sc->field, &tlvField, f[0], f[1], f[2], sc->tempFiltTenths);
+
+            sc->sampleValid = sc->present;
+            sc->lastUpdateMs = s->t_ms;
+        }
 
-                int16_t z = (int16_t)(((uint16_t)tlvData[2] << 4) | (uint16_t)(tlvData[5] & 0x0Fu));
-                if (z & 0x0800) z = (int16_t)(z - 0x1000);
+        TLV493D_OnSample(s);
 
-                /* Temp 12-bit: MS nibble in reg3, LSB byte in reg6 */
-                int16_t rawT12 = (int16_t)(((uint16_t)(tlvData[3] & 0xF0u) << 4) |
-                                           ((uint16_t) tlvData[6]));
-                if (rawT12 & 0x0800) rawT12 = (int16_t)(rawT12 - 0x1000);
+        tlvRingTail = (uint8_t)((tlvRingTail + 1u) & (TLV_RING_LEN - 1u));
+    }
 
-                lastSample.x = x;
-                lastSample.y = y;
-                lastSample.z = z;
-                lastSample.temperature = rawT12;
-                lastSample.frame = frm;
-                lastSample.channel = ch;
-                lastSample.powerDown = (pd != 0u);
+    /* After a bus recovery: a fresh sample proves the old config is still in place */
+    if (tlvResuming) {
+        uint32_t dt = nowMs - tlvRecoverT;
+
+        if (tlvStats.samples != tlvResumeSamples) {
+            tlvResuming = false;
+            tlvStats.resumes++;
+            tlvStats.resumeMs = (uint16_t)((dt > 0xFFFFu) ? 0xFFFFu : dt);
+            if (tlvStats.resumeMs > tlvStats.resumeMaxMs) tlvStats.resumeMaxMs = tlvStats.resumeMs;
+        } else if (dt > (uint32_t)tlvPeriodMs + TLV_RESUME_MS) {
+            tlvStats.reinits++;
+            TLV_BusReset();
+        }
+    }
+}
 
-                /* Derived values (filtered) */
-                TLV_UpdateHeading(x, y);
-                TLV_UpdateTemp(rawT12);
+void TLV493D_SetAcquisition(TLV493D_MODE mode, uint8_t period_ms)
+{
+    if (period_ms == 0u) period_ms = TLV493D_PERIOD_DEFAULT_MS;
+    tlvPeriodMs = period_ms;
 
-                lastFrm = frm;
-                sampleValid = true;
-                lastUpdateMs = nowMs;
+    if (mode != tlvMode) {
+        tlvMode = mode;
+        /* New MOD1/W0 config needed: full reinit (the tick stops first) */
+        TLV_BusReset();
+    }
+}
 
-                tlvFails = 0u;
-                tlvState = TLV_ST_READ_DATA;
-            } else {
-                if (I2C1_ErrorGet() != I2C_ERROR_NONE || I2C_GuardTimeout()) {
-                    TLV_FailStep();
-                }
-            }
-            break;
+void TLV493D_SetFilter(const TLV493D_FilterSet_t *set)
+{
+    if (set == NULL) return;
 
-        default:
-            tlvState = TLV_ST_RESET;
-            sampleValid = false;
-            break;
+    TLV493D_FilterSet_t n = *set;
+
+    TLV493D_FilterSanitize(&n.xyzt);
+    if (n.headingShift > TLV493D_FILT_SHIFT_MAX) n.headingShift = TLV493D_FILT_SHIFT_MAX;
+    if (n.tempShift > TLV493D_FILT_SHIFT_MAX) n.tempShift = TLV493D_FILT_SHIFT_MAX;
+    if (n.headingHystCdeg > TLV493D_CDEG_180) n.headingHystCdeg = TLV493D_CDEG_180;
+
+    bool pre = (n.xyzt.median != tlvFilt.xyzt.median) || (n.xyzt.decim != tlvFilt.xyzt.decim) ||
+               (n.xyzt.iirOrder != tlvFilt.xyzt.iirOrder) || (n.xyzt.iirShift != tlvFilt.xyzt.iirShift);
+
+    tlvFilt = n;
+
+    /* New pre-filter: restart from the next raw sample (history would mix settings) */
+    if (pre) {
+        for (uint8_t i = 0u; i < TLV493D_MAX_SENSORS; i++) {
+            TLV493D_FilterReset(&tlvCtx[i].filt);
+        }
+    }
+}
+
+void TLV493D_SetFieldCheck(const TLV493D_FieldCfg_t *cfg)
+{
+    if (cfg != NULL) {
+        tlvField = *cfg;
+    }
+}
+
+bool TLV493D_GetField(uint8_t id, uint16_t *b_lsb, uint8_t *flags)
+{
+    if (id >= tlvCount) return false;
+
+    const TLV_CTX *c = &tlvCtx[id];
+
+    if (b_lsb != NULL) *b_lsb = c->field.bComp;
+    if (flags != NULL) *flags = c->field.flags;
+    return c->sampleValid;
+}
+
+void TLV493D_GetStats(TLV493D_Stats_t *out)
+{
+    if (out != NULL) {
+        *out = tlvStats;
+    }
+}
+
+void TLV493D_SetCal(uint8_t id, const TLV493D_Cal_t *cal)
+{
+    if (id >= TLV493D_MAX_SENSORS) return;
+
+    TLV_CTX *c = &tlvCtx[id];
+
+    if (cal != NULL) {
+        c->cal = *cal;
+    } else {
+        c->cal.offX = 0;
+        c->cal.offY = 0;
+        c->cal.scaleX = TLV493D_CAL_ONE;
+        c->cal.scaleY = TLV493D_CAL_ONE;
+    }
+    /* Restart the heading filter on the new coordinates */
+    c->headingInit = false;
+}
+
+void TLV493D_GetCal(uint8_t id, TLV493D_Cal_t *out)
+{
+    if (id < TLV493D_MAX_SENSORS && out != NULL) {
+        *out = tlvCtx[id].cal;
     }
 }
 
-bool TLV493D_GetLatest(TLV493D_Data_t *out, uint32_t now_ms, uint32_t *age_ms)
+uint8_t TLV493D_GetAddress(uint8_t id)
+{
+    return (id < tlvCount && tlvCtx[id].present) ? tlvCtx[id].cfg.addr : 0u;
+}
+
+void __attribute__((weak)) TLV493D_OnSample(const TLV493D_Sample_t *s)
+{
+    (void)s;
+}
+
+static uint32_t TLV_Age(const TLV_CTX *c, uint32_t now_ms)
+{
+    return c->sampleValid ? (uint32_t)(now_ms - c->lastUpdateMs) : 0xFFFFFFFFu;
+}
+
+bool TLV493D_GetLatest(uint8_t id, TLV493D_Data_t *out, uint32_t now_ms, uint32_t *age_ms)
 {
+    if (id >= tlvCount) return false;
+
+    const TLV_CTX *c = &tlvCtx[id];
+
     if (out != NULL) {
-        *out = lastSample;
+        *out = c->lastSample;
     }
     if (age_ms != NULL) {
-        *age_ms = (sampleValid ? (uint32_t)(now_ms - lastUpdateMs) : 0xFFFFFFFFu);
+        *age_ms = TLV_Age(c, now_ms);
     }
-    return sampleValid;
+    return c->sampleValid;
 }
 
 
-bool TLV493D_GetHeadingDeg(int16_t *heading_deg, uint32_t now_ms, uint32_t *age_ms)
+bool TLV493D_GetHeadingDeg(uint8_t id, int16_t *heading_deg, uint32_t now_ms, uint32_t *age_ms)
 {
+    if (id >= tlvCount) return false;
+
+    const TLV_CTX *c = &tlvCtx[id];
+
     if (heading_deg != NULL) {
-        *heading_deg = headingStableDeg;
+        int16_t h = c->headingStableCdeg;
+        *heading_deg = (int16_t)((h + ((h < 0) ? -50 : 50)) / 100);   /* rounded */
     }
     if (age_ms != NULL) {
-        *age_ms = (sampleValid ? (uint32_t)(now_ms - lastUpdateMs) : 0xFFFFFFFFu);
+        *age_ms = TLV_Age(c, now_ms);
     }
-    return sampleValid && headingInit;
+    return c->sampleValid && c->headingInit && (c->field.flags == 0u);
 }
 
-bool TLV493D_GetTemperatureC(int16_t *temp_c, uint32_t now_ms, uint32_t *age_ms)
+bool TLV493D_GetHeadingCdeg(uint8_t id, int16_t *heading_cdeg, uint32_t now_ms, uint32_t *age_ms)
 {
+    if (id >= tlvCount) return false;
+
+    const TLV_CTX *c = &tlvCtx[id];
+
+    if (heading_cdeg != NULL) {
+        *heading_cdeg = c->headingCdeg;
+    }
+    if (age_ms != NULL) {
+        *age_ms = TLV_Age(c, now_ms);
+    }
+    return c->sampleValid && c->headingInit && (c->field.flags == 0u);
+}
+
+bool TLV493D_GetTemperatureC(uint8_t id, int16_t *temp_c, uint32_t now_ms, uint32_t *age_ms)
+{
+    if (id >= tlvCount) return false;
+
+    const TLV_CTX *c = &tlvCtx[id];
+
     if (temp_c != NULL) {
-        *temp_c = tempStableC;
+        *temp_c = c->tempStableC;
     }
     if (age_ms != NULL) {
-        *age_ms = (sampleValid ? (uint32_t)(now_ms - lastUpdateMs) : 0xFFFFFFFFu);
+        *age_ms = TLV_Age(c, now_ms);
     }
-    return sampleValid && tempInit;
+    return c->sampleValid && c->tempInit;
 }
 
-bool TLV493D_GetHeadingTemp(int16_t *heading_deg, int16_t *temp_c, uint32_t now_ms, uint32_t *age_ms)
+bool TLV493D_GetHeadingTemp(uint8_t id, int16_t *heading_deg, int16_t *temp_c, uint32_t now_ms, uint32_t *age_ms)
 {
-    bool ok_h = TLV493D_GetHeadingDeg(heading_deg, now_ms, age_ms);
-    bool ok_t = TLV493D_GetTemperatureC(temp_c, now_ms, NULL);
+    bool ok_h = TLV493D_GetHeadingDeg(id, heading_deg, now_ms, age_ms);
+    bool ok_t = TLV493D_GetTemperatureC(id, temp_c, now_ms, NULL);
     return ok_h && ok_t;
 }
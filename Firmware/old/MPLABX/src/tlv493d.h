@@ -5,6 +5,9 @@
 #include <stdbool.h>
 #include <stddef.h>
 
+#include "tlv493d_filter.h"
+#include "tlv493d_field.h"
+
 /* =========================================================================
  * Data structure (raw values from TLV493D-A1B6)
  *  - x/y/z: signed 12-bit values sign-extended to int16_t
@@ -22,34 +25,181 @@ typedef struct
     bool    powerDown;
 } TLV493D_Data_t;
 
+/* =========================================================================
+ * Timestamped sample, as produced by the acquisition path
+ * ========================================================================= */
+typedef struct
+{
+    uint32_t t_ms;          /* time the read was started */
+    int16_t  x;
+    int16_t  y;
+    int16_t  z;
+    int16_t  temperature;   /* raw 12-bit */
+    uint8_t  frame;
+    uint8_t  sensor;        /* TLV493D_ID */
+} TLV493D_Sample_t;
+
+typedef struct
+{
+    uint32_t samples;       /* valid samples delivered */
+    uint32_t stale;         /* reads with unchanged FRM or CH/PD/FF/T not ok */
+    uint32_t errors;        /* I2C errors during data reads */
+    uint32_t overflows;     /* samples dropped, ring full */
+    uint32_t resumes;       /* bus recovered, acquisition went on with the old config */
+    uint32_t reinits;       /* bus fault that needed a full reset + reconfiguration */
+    uint16_t resumeMs;      /* recovery start -> first sample, last resume */
+    uint16_t resumeMaxMs;
+} TLV493D_Stats_t;
+
+/* =========================================================================
+ * Acquisition modes
+ *  - LOWPOWER: sensor converts every 12 ms, TLV493D_Task() polls it
+ *  - MCM:      master controlled mode. TLV493D_Tick_1ms() starts a 7-byte
+ *              read every period_ms (per sensor) from the core timer ISR, the read
+ *              triggers the next conversion and is decoded in the I2C1
+ *              callback into a ring buffer. TLV493D_Task() only drains it.
+ * ========================================================================= */
+typedef enum
+{
+    TLV493D_MODE_LOWPOWER = 0,
+    TLV493D_MODE_MCM = 1
+} TLV493D_MODE;
+
+#define TLV493D_PERIOD_DEFAULT_MS   2u      /* 7-byte read at 50 kHz I2C is ~1.5 ms */
+
+/* =========================================================================
+ * Several sensors on I2C1 (backplane: horizontal, vertical, focus)
+ *
+ * All sensors come up on the same address. TLV493D_Init() takes one
+ * TLV493D_Config_t per sensor with the address it should run on; the
+ * driver assigns it at reset by writing MOD1 IICAddr, one sensor at a time:
+ *  - power == NULL: the sensor is moved to TLV493D_ADDR_RESET by the
+ *    general call reset. Only one such sensor can be used.
+ *  - power != NULL: supply switch. The sensor is powered up alone after
+ *    the reset and comes up on TLV493D_ADDR_POWERUP (SDA idle high).
+ *    Only the last switched sensor may keep that address.
+ * cfg.addr must be the base address with IICAddr applied, see
+ * TLV493D_ADDR_xxx. Entries that break these rules are never started.
+ * ========================================================================= */
+typedef enum
+{
+    TLV493D_HORIZ = 0,
+    TLV493D_VERT,
+    TLV493D_FOCUS,
+    TLV493D_MAX_SENSORS
+} TLV493D_ID;
+
+typedef struct
+{
+    uint8_t addr;               /* 7-bit address in operation */
+    void  (*power)(bool on);    /* supply switch, NULL = always powered */
+} TLV493D_Config_t;
+
+#define TLV493D_ADDR_RESET          0x1Fu   /* IICAddr 00; 01 = 0x1B, 10 = 0x0F, 11 = 0x0B */
+#define TLV493D_ADDR_POWERUP        0x5Eu   /* IICAddr 00; 01 = 0x5A, 10 = 0x4E, 11 = 0x4A */
+
 /* =========================================================================
  * Non-blocking driver API
  * =========================================================================
  * Usage pattern:
- *   - Register TLV493D_I2C_Callback as I2C1 callback
- *   - Call TLV493D_Init(addr) once at boot
- *   - Call TLV493D_Task(now_ms) periodically (e.g. every 50ms)
- *   - Call TLV493D_GetLatest(&data, now_ms, &age_ms) when you want the latest sample
+ *   - I2CBUS_Init() first, the driver uses the I2C1 transaction queue
+ *   - Call TLV493D_Init(cfg, n) once at boot
+ *   - Call TLV493D_Task(now_ms) periodically (e.g. every 10ms)
+ *   - Call TLV493D_GetLatest(id, &data, now_ms, &age_ms) when you want the latest sample
+ *
+ * Acquisition is round robin over the sensors that answered: in MCM each
+ * sensor is read every period_ms and one read is in flight at a time,
+ * so the conversions of the other sensors overlap the bus transfer.
+ * A missing sensor is skipped and retried by a full reset every 30 s.
+ *
+ * A stuck bus or a run of read errors first gets an I2C bus recovery
+ * (i2cbus.h) and acquisition goes on with the config the sensors already
+ * have. Only when no sample arrives shortly after that, or the bus is
+ * still held, is the full reset + reconfiguration done.
  */
-void TLV493D_Init(uint8_t i2c_addr);
+void TLV493D_Init(const TLV493D_Config_t *cfg, uint8_t count);
 void TLV493D_Task(uint32_t now_ms);
-bool TLV493D_GetLatest(TLV493D_Data_t *out, uint32_t now_ms, uint32_t *age_ms);
+bool TLV493D_GetLatest(uint8_t id, TLV493D_Data_t *out, uint32_t now_ms, uint32_t *age_ms);
+
+/* Address in use, 0 = sensor not present */
+uint8_t TLV493D_GetAddress(uint8_t id);
+
+/* Mode change restarts the sensor; period is only used in MCM (0 = default) */
+void TLV493D_SetAcquisition(TLV493D_MODE mode, uint8_t period_ms);
+void TLV493D_GetStats(TLV493D_Stats_t *out);
+
+/* Call from the 1 ms core timer callback (ISR context) */
+void TLV493D_Tick_1ms(uint32_t now_ms);
+
+/* Called from TLV493D_Task() for every new sample (all sensors), in order.
+ * Weak, default empty; tlv493d_fifo.c queues the samples for the host. */
+void TLV493D_OnSample(const TLV493D_Sample_t *s);
 
 
 /* =========================================================================
  * Derived/filtered convenience values (no floating point)
- *  - Heading is in whole degrees, range [-180..180]
+ *  - Heading is in whole degrees, range [-180..180], with 1 degree hysteresis,
+ *    or in centidegrees, range [-18000..18000], filtered only
  *  - Temperature is in whole C (rounded), range roughly [-50..150]
  *
  * Internally these are computed + low-pass filtered each time a new valid sample arrives.
  * Temperature conversion follows datasheet: T25=340 LSB and 1.1 C/LSB.
  * ========================================================================= */
-bool TLV493D_GetHeadingDeg(int16_t *heading_deg, uint32_t now_ms, uint32_t *age_ms);
-bool TLV493D_GetTemperatureC(int16_t *temp_c, uint32_t now_ms, uint32_t *age_ms);
-bool TLV493D_GetHeadingTemp(int16_t *heading_deg, int16_t *temp_c, uint32_t now_ms, uint32_t *age_ms);
+bool TLV493D_GetHeadingDeg(uint8_t id, int16_t *heading_deg, uint32_t now_ms, uint32_t *age_ms);
+bool TLV493D_GetHeadingCdeg(uint8_t id, int16_t *heading_cdeg, uint32_t now_ms, uint32_t *age_ms);
+bool TLV493D_GetTemperatureC(uint8_t id, int16_t *temp_c, uint32_t now_ms, uint32_t *age_ms);
+bool TLV493D_GetHeadingTemp(uint8_t id, int16_t *heading_deg, int16_t *temp_c, uint32_t now_ms, uint32_t *age_ms);
+
+/* =========================================================================
+ * Hard/soft-iron correction, applied to X/Y before the heading atan2:
+ *   x' = ((x - offX) * scaleX) >> 14
+ * Computed and stored by tlv493d_cal.c. Main loop context.
+ * ========================================================================= */
+typedef struct
+{
+    int16_t  offX;          /* LSB */
+    int16_t  offY;
+    uint16_t scaleX;        /* Q14, TLV493D_CAL_ONE = 1.0 */
+    uint16_t scaleY;
+} TLV493D_Cal_t;
+
+#define TLV493D_CAL_ONE             16384u
+
+/* cal == NULL: identity */
+void TLV493D_SetCal(uint8_t id, const TLV493D_Cal_t *cal);
+void TLV493D_GetCal(uint8_t id, TLV493D_Cal_t *out);
+
+/* =========================================================================
+ * Filter settings (all sensors). Raw X/Y/Z/T go through the pre-filter
+ * (tlv493d_filter.h); heading and temperature are derived from its output.
+ * The calibration and the sample FIFO always see the raw samples.
+ * ========================================================================= */
+#define TLV493D_HEADING_SHIFT_DEFAULT   3u      /* heading IIR 1/8 */
+#define TLV493D_HEADING_HYST_DEFAULT    100u    /* 1 degree */
+#define TLV493D_TEMP_SHIFT_DEFAULT      4u      /* temperature IIR 1/16 */
+#define TLV493D_TEMP_HYST_DEFAULT       10u     /* 1 degree C */
+
+typedef struct
+{
+    TLV493D_FilterCfg_t xyzt;
+    uint8_t  headingShift;      /* 0 (off) .. TLV493D_FILT_SHIFT_MAX */
+    uint16_t headingHystCdeg;   /* whole degree output hysteresis, 0.01 deg */
+    uint8_t  tempShift;         /* 0 (off) .. TLV493D_FILT_SHIFT_MAX */
+    uint16_t tempHystTenths;    /* whole degree C output hysteresis, 0.1 C */
+} TLV493D_FilterSet_t;
+
+/* Values are clamped; a changed pre-filter restarts from the next sample */
+void TLV493D_SetFilter(const TLV493D_FilterSet_t *set);
+
+/* =========================================================================
+ * Field magnitude check (tlv493d_field.h), on the pre-filter output.
+ * While a sensor has TLV493D_FIELD_xxx flags set, its heading getters
+ * return false: the angle of a lost or clipped field is not trustworthy.
+ * ========================================================================= */
+void TLV493D_SetFieldCheck(const TLV493D_FieldCfg_t *cfg);
 
-/* Pass this directly to I2C1_CallbackRegister() */
-void TLV493D_I2C_Callback(uintptr_t context);
+/* |B| corrected to 25 C in LSB, debounced flags. False: no valid sample */
+bool TLV493D_GetField(uint8_t id, uint16_t *b_lsb, uint8_t *flags);
 
 #endif /* TLV493D_H */
 
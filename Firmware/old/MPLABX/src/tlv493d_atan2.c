@@ -0,0 +1,50 @@
+#include "tlv493d_atan2.h"
+
+/* ===================== Table ===================== */
+#define ATAN_SEG_BITS       6u                              /* 64 segments over [0..1] */
+#define ATAN_FRAC_BITS      (16u - ATAN_SEG_BITS)
+
+/* round(atan(i / 64) in centidegrees), i = 0..64 */
+static const uint16_t atanTab[(1u << ATAN_SEG_BITS) + 1u] = {
+        0,    90,   179,   268,   358,   447,   536,   624,
+      713,   800,   888,   975,  1062,  1148,  1234,  1319,
+     1404,  1488,  1571,  1653,  1735,  1817,  1897,  1977,
+     2056,  2134,  2211,  2287,  2363,  2438,  2511,  2584,
+     2657,  2728,  2798,  2867,  2936,  3003,  3070,  3136,
+     3201,  3264,  3327,  3390,  3451,  3511,  3571,  3629,
+     3687,  3744,  3800,  3855,  3909,  3963,  4016,  4067,
+     4119,  4169,  4218,  4267,  4315,  4363,  4409,  4455,
+     4500,
+};
+
+int16_t TLV493D_Atan2Cdeg(int16_t y, int16_t x)
+{
+    uint32_t ax = (x < 0) ? (uint32_t)(-(int32_t)x) : (uint32_t)x;
+    uint32_t ay = (y < 0) ? (uint32_t)(-(int32_t)y) : (uint32_t)y;
+    uint32_t num, den, r, idx, frac;
+    int32_t a;
+
+    if (ax == 0u && ay == 0u) return 0;
+
+    /* First octant: r = min/max in Q16, 0..65536 (num <= 32768 so no overflow) */
+    if (ay > ax) { num = ax; den = ay; }
+    else         { num = ay; den = ax; }
+    r = (num << 16) / den;
+
+    idx = r >> ATAN_FRAC_BITS;
+    frac = r & ((1u << ATAN_FRAC_BITS) - 1u);
+    if (idx >= (1u << ATAN_SEG_BITS)) {
+        a = (int32_t)atanTab[1u << ATAN_SEG_BITS];
+    } else {
+        int32_t d = (int32_t)atanTab[idx + 1u] - (int32_t)atanTab[idx];
+        a = (int32_t)atanTab[idx] +
+            ((d * (int32_t)frac + (1 << (ATAN_FRAC_BITS - 1u))) >> ATAN_FRAC_BITS);
+    }
+
+    /* Unfold octant -> quadrant -> half plane */
+    if (ay > ax) a = (TLV493D_CDEG_180 / 2) - a;
+    if (x < 0)   a = TLV493D_CDEG_180 - a;
+    if (y < 0)   a = -a;
+
+    return (int16_t)a;
+}
@@ -0,0 +1,19 @@
+#ifndef TLV493D_ATAN2_H
+#define TLV493D_ATAN2_H
+
+#include <stdint.h>
+
+/* =========================================================================
+ * Fixed-point atan2 for the TLV493D heading
+ *
+ * Octant reduction, one 32-bit divide and a 65-entry atan table with
+ * linear interpolation. Max error is about 0.01 degree for 12-bit input
+ * (see host/atan2_bench.c). No floating point, no dependencies, so the
+ * same file builds on the host.
+ * ========================================================================= */
+#define TLV493D_CDEG_180            18000
+
+/* atan2(y, x) in centidegrees, range [-18000..18000]. atan2(0, 0) = 0. */
+int16_t TLV493D_Atan2Cdeg(int16_t y, int16_t x);
+
+#endif /* TLV493D_ATAN2_H */
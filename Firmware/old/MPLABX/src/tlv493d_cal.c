@@ -0,0 +1,277 @@
+#include <math.h>
+#include <string.h>
+#include "definitions.h"
+#include "ModbusSlave.h"
+#include "nvstore.h"
+#include "tlv493d_atan2.h"
+#include "tlv493d_cal.h"
+
+/* ===================== Constants ===================== */
+#define CAL_MAX_SAMPLES     100000u         /* keeps sum(x^4) inside int64 for 12-bit input */
+#define CAL_NORM            1024.0          /* fit in units of 1024 LSB (conditioning) */
+#define CAL_SECTORS_ALL     0xFFFFu
+
+/* ===================== Accumulator ===================== */
+typedef struct {
+    uint32_t n;
+    int16_t  minX, maxX, minY, maxY;
+    uint16_t sectors;
+    /* sum of x^i * y^j, named sIJ */
+    int64_t  s40, s22, s04, s30, s21, s12, s03, s20, s11, s02;
+    int64_t  s10, s01;
+} CAL_ACC;
+
+static CAL_ACC calAcc;
+static TLV493D_CAL_STATE calState = TLV493D_CAL_IDLE;
+static TLV493D_CAL_RESULT calResult = TLV493D_CAL_RES_NONE;
+static uint8_t  calSensor = 0u;
+static uint16_t calStored = 0u;                 /* bit per sensor */
+
+static TLV493D_Cal_t calTab[TLV493D_MAX_SENSORS];
+
+static void CAL_Clear(void)
+{
+    memset(&calAcc, 0, sizeof(calAcc));
+    calAcc.minX = INT16_MAX;
+    calAcc.minY = INT16_MAX;
+    calAcc.maxX = INT16_MIN;
+    calAcc.maxY = INT16_MIN;
+}
+
+void TLV493D_CalFeed(const TLV493D_Sample_t *s)
+{
+    if (calState != TLV493D_CAL_RUNNING || s->sensor != calSensor) return;
+
+    int32_t x = s->x, y = s->y;
+
+    if (s->x < calAcc.minX) calAcc.minX = s->x;
+    if (s->x > calAcc.maxX) calAcc.maxX = s->x;
+    if (s->y < calAcc.minY) calAcc.minY = s->y;
+    if (s->y > calAcc.maxY) calAcc.maxY = s->y;
+
+    /* Coverage around the current min/max centre */
+    int32_t cx = x - ((int32_t)calAcc.minX + calAcc.maxX) / 2;
+    int32_t cy = y - ((int32_t)calAcc.minY + calAcc.maxY) / 2;
+    if ((calAcc.maxX - calAcc.minX) >= 2 * TLV493D_CAL_MIN_RADIUS &&
+        (calAcc.maxY - calAcc.minY) >= 2 * TLV493D_CAL_MIN_RADIUS) {
+        int32_t a = (int32_t)TLV493D_Atan2Cdeg((int16_t)cy, (int16_t)cx) + TLV493D_CDEG_180;
+        uint32_t sector = ((uint32_t)a * 16u) / (2u * TLV493D_CDEG_180);
+        calAcc.sectors |= (uint16_t)(1u << ((sector > 15u) ? 15u : sector));
+    }
+
+    if (calAcc.n >= CAL_MAX_SAMPLES) return;
+    calAcc.n++;
+
+    int32_t x2 = x * x, y2 = y * y;
+
+    calAcc.s40 += (int64_t)x2 * x2;
+    calAcc.s22 += (int64_t)x2 * y2;
+    calAcc.s04 += (int64_t)y2 * y2;
+    calAcc.s30 += (int64_t)x2 * x;
+    calAcc.s21 += (int64_t)x2 * y;
+    calAcc.s12 += (int64_t)y2 * x;
+    calAcc.s03 += (int64_t)y2 * y;
+    calAcc.s20 += x2;
+    calAcc.s11 += (int64_t)x * y;
+    calAcc.s02 += y2;
+    calAcc.s10 += x;
+    calAcc.s01 += y;
+}
+
+/* Gauss elimination with partial pivoting, m = [A | b], result in m[i][4] */
+static bool CAL_Solve4(double m[4][5])
+{
+    for (int c = 0; c < 4; c++) {
+        int p = c;
+        for (int r = c + 1; r < 4; r++) {
+            if (fabs(m[r][c]) > fabs(m[p][c])) p = r;
+        }
+        if (fabs(m[p][c]) < 1e-12) return false;
+        if (p != c) {
+            for (int k = 0; k < 5; k++) {
+                double t = m[c][k]; m[c][k] = m[p][k]; m[p][k] = t;
+            }
+        }
+        for (int r = 0; r < 4; r++) {
+            if (r == c) continue;
+            double f = m[r][c] / m[c][c];
+            for (int k = c; k < 5; k++) m[r][k] -= f * m[c][k];
+        }
+    }
+    for (int r = 0; r < 4; r++) m[r][4] /= m[r][r];
+    return true;
+}
+
+/* Ellipse fit: centre and radii in LSB. False if degenerate or outside the min/max box. */
+static bool CAL_FitEllipse(double *ox, double *oy, double *rx, double *ry)
+{
+    const double k1 = 1.0 / CAL_NORM, k2 = k1 * k1, k3 = k2 * k1, k4 = k2 * k2;
+    double m[4][5] = {
+        { calAcc.s40 * k4, calAcc.s22 * k4, calAcc.s30 * k3, calAcc.s21 * k3, calAcc.s20 * k2 },
+        { calAcc.s22 * k4, calAcc.s04 * k4, calAcc.s12 * k3, calAcc.s03 * k3, calAcc.s02 * k2 },
+        { calAcc.s30 * k3, calAcc.s12 * k3, calAcc.s20 * k2, calAcc.s11 * k2, calAcc.s10 * k1 },
+        { calAcc.s21 * k3, calAcc.s03 * k3, calAcc.s11 * k2, calAcc.s02 * k2, calAcc.s01 * k1 },
+    };
+
+    if (!CAL_Solve4(m)) return false;
+
+    double A = m[0][4], B = m[1][4], C = m[2][4], D = m[3][4];
+    if (A <= 0.0 || B <= 0.0) return false;
+
+    double G = 1.0 + C * C / (4.0 * A) + D * D / (4.0 * B);
+    if (G <= 0.0) return false;
+
+    *ox = -C / (2.0 * A) * CAL_NORM;
+    *oy = -D / (2.0 * B) * CAL_NORM;
+    *rx = sqrt(G / A) * CAL_NORM;
+    *ry = sqrt(G / B) * CAL_NORM;
+
+    /* Plausible against the min/max box */
+    double hx = (calAcc.maxX - calAcc.minX) / 2.0;
+    double hy = (calAcc.maxY - calAcc.minY) / 2.0;
+    if (*ox < calAcc.minX || *ox > calAcc.maxX || *oy < calAcc.minY || *oy > calAcc.maxY) return false;
+    if (*rx < 0.5 * hx || *rx > 2.0 * hx || *ry < 0.5 * hy || *ry > 2.0 * hy) return false;
+    return true;
+}
+
+static uint16_t CAL_Q14(double v)
+{
+    double q = v * TLV493D_CAL_ONE + 0.5;
+
+    if (q < TLV493D_CAL_ONE / 2u) q = TLV493D_CAL_ONE / 2u;
+    if (q > 2u * TLV493D_CAL_ONE - 1u) q = 2u * TLV493D_CAL_ONE - 1u;
+    return (uint16_t)q;
+}
+
+static void CAL_Store(uint8_t id, const TLV493D_Cal_t *cal)
+{
+    calTab[id] = *cal;
+    TLV493D_SetCal(id, cal);
+
+    if (NVS_Write(NVS_ID_TLV_CAL, calTab, (uint16_t)sizeof(calTab))) {
+        calStored |= (uint16_t)(1u << id);
+    } else {
+        calResult = TLV493D_CAL_RES_FLASH;
+    }
+}
+
+static void CAL_Finish(void)
+{
+    double ox, oy, rx, ry;
+    TLV493D_Cal_t cal;
+
+    calState = TLV493D_CAL_FAILED;
+
+    if (calAcc.n < TLV493D_CAL_MIN_SAMPLES) {
+        calResult = TLV493D_CAL_RES_FEW_SAMPLES;
+        return;
+    }
+    if ((calAcc.maxX - calAcc.minX) < 2 * TLV493D_CAL_MIN_RADIUS ||
+        (calAcc.maxY - calAcc.minY) < 2 * TLV493D_CAL_MIN_RADIUS) {
+        calResult = TLV493D_CAL_RES_NO_FIELD;
+        return;
+    }
+    if (calAcc.sectors != CAL_SECTORS_ALL) {
+        calResult = TLV493D_CAL_RES_NOT_FULL_TURN;
+        return;
+    }
+
+    if (CAL_FitEllipse(&ox, &oy, &rx, &ry)) {
+        calResult = TLV493D_CAL_RES_ELLIPSE;
+    } else {
+        ox = ((double)calAcc.minX + calAcc.maxX) / 2.0;
+        oy = ((double)calAcc.minY + calAcc.maxY) / 2.0;
+        rx = ((double)calAcc.maxX - calAcc.minX) / 2.0;
+        ry = ((double)calAcc.maxY - calAcc.minY) / 2.0;
+        calResult = TLV493D_CAL_RES_MINMAX;
+    }
+
+    /* Scale both axes to the mean radius */
+    cal.offX = (int16_t)lround(ox);
+    cal.offY = (int16_t)lround(oy);
+    cal.scaleX = CAL_Q14(((rx + ry) / 2.0) / rx);
+    cal.scaleY = CAL_Q14(((rx + ry) / 2.0) / ry);
+
+    calState = TLV493D_CAL_DONE;
+    CAL_Store(calSensor, &cal);
+}
+
+void TLV493D_CalInit(void)
+{
+    for (uint8_t i = 0u; i < TLV493D_MAX_SENSORS; i++) TLV493D_GetCal(i, &calTab[i]);
+
+    if (NVS_Read(NVS_ID_TLV_CAL, calTab, (uint16_t)sizeof(calTab))) {
+        for (uint8_t i = 0u; i < TLV493D_MAX_SENSORS; i++) {
+            if (calTab[i].scaleX != 0u && calTab[i].scaleY != 0u) {
+                TLV493D_SetCal(i, &calTab[i]);
+                calStored |= (uint16_t)(1u << i);
+            }
+        }
+    }
+}
+
+void TLV493D_CalTask_250ms(void)
+{
+    uint16_t cmd = MBS_HoldRegisters[MBS_TLV493D_CAL_CMD];
+    uint16_t id = MBS_HoldRegisters[MBS_TLV493D_CAL_SENSOR];
+
+    if (cmd != TLV493D_CAL_CMD_NONE) {
+        MBS_HoldRegisters[MBS_TLV493D_CAL_CMD] = TLV493D_CAL_CMD_NONE;
+
+        switch (cmd) {
+            case TLV493D_CAL_CMD_START:
+                if (id >= TLV493D_MAX_SENSORS) {
+                    calState = TLV493D_CAL_FAILED;
+                    calResult = TLV493D_CAL_RES_BAD_SENSOR;
+                    break;
+                }
+                CAL_Clear();
+                calSensor = (uint8_t)id;
+                calResult = TLV493D_CAL_RES_NONE;
+                calState = TLV493D_CAL_RUNNING;
+                break;
+
+            case TLV493D_CAL_CMD_FINISH:
+                if (calState == TLV493D_CAL_RUNNING) CAL_Finish();
+                break;
+
+            case TLV493D_CAL_CMD_ABORT:
+                if (calState == TLV493D_CAL_RUNNING) calState = TLV493D_CAL_IDLE;
+                break;
+
+            case TLV493D_CAL_CMD_CLEAR:
+                if (id >= TLV493D_MAX_SENSORS) {
+                    calResult = TLV493D_CAL_RES_BAD_SENSOR;
+                    break;
+                }
+                if (calState == TLV493D_CAL_RUNNING && calSensor == id) calState = TLV493D_CAL_IDLE;
+                {
+                    TLV493D_Cal_t ident = { 0, 0, TLV493D_CAL_ONE, TLV493D_CAL_ONE };
+                    calResult = TLV493D_CAL_RES_CLEARED;
+                    CAL_Store((uint8_t)id, &ident);
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    MBS_InputRegisters[MBS_IR_TLVCAL_STATE]   = (uint16_t)calState;
+    MBS_InputRegisters[MBS_IR_TLVCAL_SENSOR]  = calSensor;
+    MBS_InputRegisters[MBS_IR_TLVCAL_SAMPLES] = (uint16_t)((calAcc.n > 0xFFFFu) ? 0xFFFFu : calAcc.n);
+    MBS_InputRegisters[MBS_IR_TLVCAL_SECTORS] = calAcc.sectors;
+    MBS_InputRegisters[MBS_IR_TLVCAL_RESULT]  = (uint16_t)calResult;
+    MBS_InputRegisters[MBS_IR_TLVCAL_STORED]  = calStored;
+
+    for (uint8_t i = 0u; i < TLV493D_MAX_SENSORS; i++) {
+        volatile uint16_t *r = &MBS_InputRegisters[MBS_IR_TLVCAL_COEF + i * MBS_IR_TLVCAL_COEF_STRIDE];
+        TLV493D_Cal_t cal;
+
+        TLV493D_GetCal(i, &cal);
+        r[MBS_IR_TLVCAL_OFF_X]   = (uint16_t)cal.offX;
+        r[MBS_IR_TLVCAL_OFF_Y]   = (uint16_t)cal.offY;
+        r[MBS_IR_TLVCAL_SCALE_X] = cal.scaleX;
+        r[MBS_IR_TLVCAL_SCALE_Y] = cal.scaleY;
+    }
+}
@@ -0,0 +1,63 @@
+#ifndef TLV493D_CAL_H
+#define TLV493D_CAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "tlv493d.h"
+
+/* =========================================================================
+ * On-device hard/soft-iron calibration for the TLV493D heading
+ *
+ * While the axis is turned through at least one full revolution, every
+ * raw sample of the selected sensor updates min/max, a 16-sector
+ * coverage mask and the running sums of a least squares fit of the
+ * axis-aligned ellipse A*x^2 + B*y^2 + C*x + D*y = 1 (no samples stored).
+ *
+ * FINISH solves the 4x4 normal equations once (soft float, main loop),
+ * giving centre (offset) and radii (scale). If the fit is degenerate
+ * the min/max box is used instead. The coefficients are stored with
+ * NVS_Write() and applied by the driver with integer math.
+ *
+ * Host interface: MBS_TLV493D_CAL_CMD / _CAL_SENSOR (holding),
+ * MBS_IR_TLVCAL_xxx (input).
+ * ========================================================================= */
+typedef enum {
+    TLV493D_CAL_CMD_NONE = 0,
+    TLV493D_CAL_CMD_START,      /* clear the sums, start on CAL_SENSOR */
+    TLV493D_CAL_CMD_FINISH,     /* compute, apply and store */
+    TLV493D_CAL_CMD_ABORT,      /* stop, keep the old coefficients */
+    TLV493D_CAL_CMD_CLEAR       /* identity for CAL_SENSOR, stored */
+} TLV493D_CAL_CMD;
+
+typedef enum {
+    TLV493D_CAL_IDLE = 0,
+    TLV493D_CAL_RUNNING,
+    TLV493D_CAL_DONE,
+    TLV493D_CAL_FAILED
+} TLV493D_CAL_STATE;
+
+typedef enum {
+    TLV493D_CAL_RES_NONE = 0,
+    TLV493D_CAL_RES_ELLIPSE,        /* ellipse fit used */
+    TLV493D_CAL_RES_MINMAX,         /* fit rejected, min/max box used */
+    TLV493D_CAL_RES_CLEARED,
+    TLV493D_CAL_RES_FEW_SAMPLES = 0x8001,
+    TLV493D_CAL_RES_NOT_FULL_TURN,
+    TLV493D_CAL_RES_NO_FIELD,       /* radius below TLV493D_CAL_MIN_RADIUS */
+    TLV493D_CAL_RES_FLASH,          /* applied, but not stored */
+    TLV493D_CAL_RES_BAD_SENSOR
+} TLV493D_CAL_RESULT;
+
+#define TLV493D_CAL_MIN_SAMPLES     64u
+#define TLV493D_CAL_MIN_RADIUS      20      /* LSB, ~2 mT */
+
+/** Load stored coefficients into the driver. Call after NVS_Init() and TLV493D_Init(). */
+void TLV493D_CalInit(void);
+
+/** Called by TLV493D_Task() for every new sample. */
+void TLV493D_CalFeed(const TLV493D_Sample_t *s);
+
+/** Handle the command register and publish the state. Call at 250 ms cadence. */
+void TLV493D_CalTask_250ms(void);
+
+#endif /* TLV493D_CAL_H */
@@ -0,0 +1,79 @@
+#include "tlv493d_field.h"
+
+#define FIELD_CORR_MAX_PPM      500000L     /* +-50 %, keeps b * ppm in int32 */
+
+uint16_t TLV493D_Isqrt32(uint32_t v)
+{
+    uint32_t r = 0u;
+    uint32_t bit = 1uL << 30;
+
+    while (bit > v) bit >>= 2;
+
+    while (bit != 0u) {
+        if (v >= r + bit) {
+            v -= r + bit;
+            r = (r >> 1) + bit;
+        } else {
+            r >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint16_t)r;
+}
+
+uint16_t TLV493D_FieldComp(uint16_t b, int32_t temp_tenths, int16_t tc_ppm)
+{
+    /* ppm to add: -tc * dT, dT in 0.1 K */
+    int32_t corr = -((int32_t)tc_ppm * (temp_tenths - 250)) / 10;
+
+    if (corr > FIELD_CORR_MAX_PPM)  corr = FIELD_CORR_MAX_PPM;
+    if (corr < -FIELD_CORR_MAX_PPM) corr = -FIELD_CORR_MAX_PPM;
+
+    int32_t bc = (int32_t)b + ((int32_t)b * corr) / 1000000L;
+
+    return (uint16_t)((bc < 0) ? 0 : ((bc > 0xFFFF) ? 0xFFFF : bc));
+}
+
+void TLV493D_FieldReset(TLV493D_Field_t *f)
+{
+    f->bComp = 0u;
+    f->flags = 0u;
+    f->run = 0u;
+    f->pending = 0u;
+}
+
+static int16_t FIELD_Abs(int16_t v)
+{
+    return (int16_t)((v < 0) ? -v : v);
+}
+
+uint8_t TLV493D_FieldUpdate(TLV493D_Field_t *f, const TLV493D_FieldCfg_t *cfg,
+                            int16_t x, int16_t y, int16_t z, int32_t temp_tenths)
+{
+    uint32_t b2 = (uint32_t)((int32_t)x * x) + (uint32_t)((int32_t)y * y) + (uint32_t)((int32_t)z * z);
+    uint8_t now = 0u;
+
+    f->bComp = TLV493D_FieldComp(TLV493D_Isqrt32(b2), temp_tenths, cfg->tcPpm);
+
+    if (cfg->bMin != 0u && f->bComp < cfg->bMin) now |= TLV493D_FIELD_WEAK;
+    if ((cfg->bMax != 0u && f->bComp > cfg->bMax) ||
+        FIELD_Abs(x) >= TLV493D_FIELD_FULL_SCALE ||
+        FIELD_Abs(y) >= TLV493D_FIELD_FULL_SCALE ||
+        FIELD_Abs(z) >= TLV493D_FIELD_FULL_SCALE) {
+        now |= TLV493D_FIELD_SATURATED;
+    }
+
+    if (now == f->flags) {
+        f->run = 0u;
+    } else {
+        if (now != f->pending) {
+            f->pending = now;
+            f->run = 0u;
+        }
+        if (++f->run >= TLV493D_FIELD_DEBOUNCE) {
+            f->flags = now;
+            f->run = 0u;
+        }
+    }
+    return f->flags;
+}
@@ -0,0 +1,56 @@
+#ifndef TLV493D_FIELD_H
+#define TLV493D_FIELD_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* =========================================================================
+ * Field magnitude health check for the TLV493D, integer only
+ *
+ * |B| = sqrt(x^2 + y^2 + z^2) in raw LSB (1 LSB = 98 uT), corrected to
+ * 25 C for the remanence drift of the magnet:
+ *   |B|25 = |B| * (1 - tc * (T - 25 C)),  tc in ppm/K (NdFeB ~ -1200)
+ * The heading is a ratio of X and Y and does not see this drift; the
+ * correction keeps the thresholds valid over temperature.
+ *
+ * Flags change after TLV493D_FIELD_DEBOUNCE samples in the new state.
+ * No dependencies, the same file builds on the host.
+ * ========================================================================= */
+#define TLV493D_FIELD_WEAK          0x01u   /* |B|25 < bMin: magnet lost or moved away */
+#define TLV493D_FIELD_SATURATED     0x02u   /* |B|25 > bMax or an axis at full scale */
+
+#define TLV493D_FIELD_FULL_SCALE    2040    /* |axis| >= this: ADC clipped (12 bit) */
+#define TLV493D_FIELD_DEBOUNCE      4u
+
+#define TLV493D_FIELD_BMIN_DEFAULT  100u    /* ~10 mT */
+#define TLV493D_FIELD_BMAX_DEFAULT  1300u   /* ~127 mT, close to the +-130 mT range */
+#define TLV493D_FIELD_TC_DEFAULT    (-1200) /* ppm/K, NdFeB */
+
+typedef struct
+{
+    uint16_t bMin;          /* LSB at 25 C, 0 = no weak check */
+    uint16_t bMax;          /* LSB at 25 C, 0 = no magnitude limit (full scale check stays) */
+    int16_t  tcPpm;         /* magnet temperature coefficient, ppm/K */
+} TLV493D_FieldCfg_t;
+
+typedef struct
+{
+    uint16_t bComp;         /* last |B|25, LSB */
+    uint8_t  flags;         /* TLV493D_FIELD_xxx, debounced */
+    uint8_t  run;           /* samples with a different raw state */
+    uint8_t  pending;       /* that raw state */
+} TLV493D_Field_t;
+
+/** floor(sqrt(v)) */
+uint16_t TLV493D_Isqrt32(uint32_t v);
+
+/** |B| corrected to 25 C. temp_tenths: die temperature in 0.1 C. */
+uint16_t TLV493D_FieldComp(uint16_t b, int32_t temp_tenths, int16_t tc_ppm);
+
+void TLV493D_FieldReset(TLV493D_Field_t *f);
+
+/** One sample; returns the debounced flags. */
+uint8_t TLV493D_FieldUpdate(TLV493D_Field_t *f, const TLV493D_FieldCfg_t *cfg,
+                            int16_t x, int16_t y, int16_t z, int32_t temp_tenths);
+
+#endif /* TLV493D_FIELD_H */
@@ -0,0 +1,62 @@
+#include "definitions.h"
+#include "ModbusSlave.h"
+#include "seqring.h"
+#include "tlv493d_fifo.h"
+
+/* ===================== FIFO ===================== */
+typedef struct {
+    uint32_t t_ms;
+    int16_t  x;
+    int16_t  y;
+    int16_t  z;
+    uint16_t tf;            /* MBS_IR_TLVFIFO_TEMP_FRAME layout */
+} FIFO_ENTRY;
+
+_Static_assert(MBS_IR_TLVFIFO_ENTRY == MBS_IR_TLVFIFO_BASE + SEQRING_IR_ENTRY, "TLVFIFO header is the seqring one");
+
+static FIFO_ENTRY fifoBuf[TLV493D_FIFO_LEN];
+static uint16_t fifoSeq[TLV493D_FIFO_LEN];
+static SEQRING_DEFINE(fifo, fifoSeq);
+
+void TLV493D_FifoInit(void)
+{
+    SEQRING_Reset(&fifo);
+}
+
+/* Main loop, from TLV493D_Task() */
+void TLV493D_OnSample(const TLV493D_Sample_t *s)
+{
+    uint16_t slot;
+
+    if (!SEQRING_Claim(&fifo, &slot)) return;
+
+    FIFO_ENTRY *e = &fifoBuf[slot];
+
+    e->t_ms = s->t_ms;
+    e->x = s->x;
+    e->y = s->y;
+    e->z = s->z;
+    e->tf = (uint16_t)(((uint16_t)s->temperature << 4) |
+                       ((uint16_t)(s->sensor & 0x03u) << 2) |
+                       (uint16_t)(s->frame & 0x03u));
+    SEQRING_Push(&fifo);
+}
+
+static void FIFO_Put(uint16_t slot, volatile uint16_t *r)
+{
+    const FIFO_ENTRY *e = &fifoBuf[slot];
+
+    r[MBS_IR_TLVFIFO_T_MS]       = (uint16_t)e->t_ms;
+    r[MBS_IR_TLVFIFO_X]          = (uint16_t)e->x;
+    r[MBS_IR_TLVFIFO_Y]          = (uint16_t)e->y;
+    r[MBS_IR_TLVFIFO_Z]          = (uint16_t)e->z;
+    r[MBS_IR_TLVFIFO_TEMP_FRAME] = e->tf;
+}
+
+void TLV493D_FifoOnRead(uint16_t start, uint16_t count)
+{
+    if (start != MBS_IR_TLVFIFO_BASE) return;
+
+    SEQRING_Read(&fifo, &MBS_InputRegisters[MBS_IR_TLVFIFO_BASE], count,
+                 MBS_IR_TLVFIFO_ENTRIES, MBS_IR_TLVFIFO_STRIDE, FIFO_Put);
+}
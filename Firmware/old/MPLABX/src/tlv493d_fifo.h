@@ -0,0 +1,29 @@
+#ifndef TLV493D_FIFO_H
+#define TLV493D_FIFO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "tlv493d.h"
+
+/* =========================================================================
+ * Timestamped raw sample FIFO for the host
+ *
+ * Every sample delivered by TLV493D_Task() (all sensors) is queued here
+ * through the TLV493D_OnSample() hook. A Modbus function 4 read starting at
+ * MBS_IR_TLVFIFO_BASE pops up to MBS_IR_TLVFIFO_ENTRIES entries into the
+ * input registers, so the host gets the whole stream with one request per
+ * batch. When full, new samples are dropped and counted.
+ *
+ * The ring is seqring.h. The read is destructive: a lost response loses
+ * its entries. Every sample, dropped or not, gets a 16-bit sequence
+ * number. One read only returns consecutive entries, so the host finds
+ * every gap from MBS_IR_TLVFIFO_SEQ of the next read.
+ * ========================================================================= */
+#define TLV493D_FIFO_LEN            128u    /* power of two, ~256 ms at 500 samples/s */
+
+void TLV493D_FifoInit(void);
+
+/** Call from MBS_OnReadInputRegisters(). Main loop context. */
+void TLV493D_FifoOnRead(uint16_t start, uint16_t count);
+
+#endif /* TLV493D_FIFO_H */
@@ -0,0 +1,80 @@
+#include "tlv493d_filter.h"
+
+#define FILT_Q      8
+
+void TLV493D_FilterSanitize(TLV493D_FilterCfg_t *cfg)
+{
+    if (cfg->median <= 1u) cfg->median = 1u;
+    else if (cfg->median <= 3u) cfg->median = 3u;
+    else cfg->median = TLV493D_FILT_MEDIAN_MAX;
+
+    if (cfg->decim == 0u) cfg->decim = 1u;
+    if (cfg->decim > TLV493D_FILT_DECIM_MAX) cfg->decim = TLV493D_FILT_DECIM_MAX;
+
+    if (cfg->iirOrder > TLV493D_FILT_ORDER_MAX) cfg->iirOrder = TLV493D_FILT_ORDER_MAX;
+
+    if (cfg->iirShift == 0u) cfg->iirShift = 1u;
+    if (cfg->iirShift > TLV493D_FILT_SHIFT_MAX) cfg->iirShift = TLV493D_FILT_SHIFT_MAX;
+}
+
+void TLV493D_FilterReset(TLV493D_Filter_t *f)
+{
+    f->histN = 0u;
+    f->histPos = 0u;
+    f->accN = 0u;
+    f->iirInit = false;
+    for (uint8_t c = 0u; c < TLV493D_FILT_CH; c++) f->acc[c] = 0;
+}
+
+/* Median of the first n values (n <= 5), insertion sort on a copy */
+static int16_t FILT_Median(const int16_t *v, uint8_t n)
+{
+    int16_t s[TLV493D_FILT_MEDIAN_MAX];
+
+    for (uint8_t i = 0u; i < n; i++) {
+        int16_t x = v[i];
+        uint8_t j = i;
+        while (j > 0u && s[j - 1u] > x) {
+            s[j] = s[j - 1u];
+            j--;
+        }
+        s[j] = x;
+    }
+    return s[n / 2u];
+}
+
+bool TLV493D_FilterRun(TLV493D_Filter_t *f, const TLV493D_FilterCfg_t *cfg,
+                       const int16_t in[TLV493D_FILT_CH], int16_t out[TLV493D_FILT_CH])
+{
+    uint8_t c;
+
+    /* 1. median; until the window is full, of what there is */
+    for (c = 0u; c < TLV493D_FILT_CH; c++) f->hist[c][f->histPos] = in[c];
+    if (++f->histPos >= cfg->median) f->histPos = 0u;
+    if (f->histN < cfg->median) f->histN++;
+
+    /* 2. decimation */
+    for (c = 0u; c < TLV493D_FILT_CH; c++) {
+        f->acc[c] += (f->histN > 1u) ? FILT_Median(f->hist[c], f->histN) : in[c];
+    }
+    if (++f->accN < cfg->decim) return false;
+
+    for (c = 0u; c < TLV493D_FILT_CH; c++) {
+        int32_t x = f->acc[c];
+        /* rounded average */
+        x = (x >= 0) ? (x + f->accN / 2) / f->accN : (x - f->accN / 2) / f->accN;
+        f->acc[c] = 0;
+
+        /* 3. IIR */
+        int32_t y = x << FILT_Q;
+        for (uint8_t k = 0u; k < cfg->iirOrder; k++) {
+            if (!f->iirInit) f->iir[c][k] = y;
+            f->iir[c][k] += (y - f->iir[c][k]) >> cfg->iirShift;
+            y = f->iir[c][k];
+        }
+        out[c] = (int16_t)((y + (1 << (FILT_Q - 1))) >> FILT_Q);
+    }
+    f->accN = 0u;
+    f->iirInit = true;
+    return true;
+}
@@ -0,0 +1,55 @@
+#ifndef TLV493D_FILTER_H
+#define TLV493D_FILTER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* =========================================================================
+ * Per-channel sample filter for the TLV493D (X, Y, Z, T), integer only
+ *
+ * Runs at sample rate in this order:
+ *  1. median of the last N raw samples (glitch rejection), N = 1, 3 or 5
+ *  2. decimation: average of D medians, one output per D inputs (1..16)
+ *  3. IIR: 0..2 cascaded first order sections, y += (x - y) / 2^shift,
+ *     state with 8 fraction bits
+ *
+ * No dependencies, the same file builds on the host.
+ * ========================================================================= */
+#define TLV493D_FILT_CH             4u      /* X, Y, Z, T */
+#define TLV493D_FILT_MEDIAN_MAX     5u
+#define TLV493D_FILT_DECIM_MAX      16u
+#define TLV493D_FILT_ORDER_MAX      2u
+#define TLV493D_FILT_SHIFT_MAX      8u
+
+typedef struct
+{
+    uint8_t median;         /* 1 (off), 3 or 5 */
+    uint8_t decim;          /* 1 (off) .. TLV493D_FILT_DECIM_MAX */
+    uint8_t iirOrder;       /* 0 (off) .. TLV493D_FILT_ORDER_MAX */
+    uint8_t iirShift;       /* 1 .. TLV493D_FILT_SHIFT_MAX */
+} TLV493D_FilterCfg_t;
+
+typedef struct
+{
+    int16_t hist[TLV493D_FILT_CH][TLV493D_FILT_MEDIAN_MAX];
+    uint8_t histN;
+    uint8_t histPos;
+    int32_t acc[TLV493D_FILT_CH];
+    uint8_t accN;
+    bool    iirInit;
+    int32_t iir[TLV493D_FILT_CH][TLV493D_FILT_ORDER_MAX];
+} TLV493D_Filter_t;
+
+/** Clamp cfg to the supported values (median even -> next odd, ...). */
+void TLV493D_FilterSanitize(TLV493D_FilterCfg_t *cfg);
+
+void TLV493D_FilterReset(TLV493D_Filter_t *f);
+
+/**
+ * Feed one raw sample. Returns true and writes out[] when the decimator
+ * produced an output sample.
+ */
+bool TLV493D_FilterRun(TLV493D_Filter_t *f, const TLV493D_FilterCfg_t *cfg,
+                       const int16_t in[TLV493D_FILT_CH], int16_t out[TLV493D_FILT_CH]);
+
+#endif /* TLV493D_FILTER_H */